@@ -0,0 +1,70 @@
+#include "BatchAssignment.h"
+
+BatchAssignment::BatchAssignment()
+{
+	clear();
+}
+
+void BatchAssignment::clear(){
+	bidderStart.assign(1, 0);
+	edgeObject.clear();
+	edgeBenefit.clear();
+	objectCount = 0;
+}
+
+int BatchAssignment::addBidder(){
+	bidderStart.push_back(edgeObject.size());
+	return bidderStart.size() - 2;
+}
+
+void BatchAssignment::addEdge(int object, float benefit){
+	edgeObject.push_back(object);
+	edgeBenefit.push_back(benefit);
+	bidderStart.back()++;
+	if (object >= objectCount){
+		objectCount = object + 1;
+	}
+}
+
+void BatchAssignment::solve(float epsilon){
+	size_t bidderCount = getBidderCount();
+	prices.assign(objectCount, 0);
+	objectOwner.assign(objectCount, -1);
+	assignedEdge.assign(bidderCount, -1);
+	biddersWaiting.clear();
+	for (size_t i = bidderCount; i > 0; i--){
+		if (bidderStart[i] > bidderStart[i - 1]){
+			biddersWaiting.push_back(i - 1);
+		}
+	}
+	//Prices only rise, so a bidder whose best choice is staying unmatched never bids again.
+	while (!biddersWaiting.empty()){
+		int bidder = biddersWaiting.back();
+		biddersWaiting.pop_back();
+		int bestEdge = -1;
+		float bestValue = 0;
+		float secondValue = 0;
+		for (int edge = bidderStart[bidder]; edge < bidderStart[bidder + 1]; edge++){
+			float value = edgeBenefit[edge] - prices[edgeObject[edge]];
+			if (value > bestValue){
+				secondValue = bestValue;
+				bestValue = value;
+				bestEdge = edge;
+			}
+			else if (value > secondValue){
+				secondValue = value;
+			}
+		}
+		if (bestEdge == -1){
+			continue;
+		}
+		int object = edgeObject[bestEdge];
+		prices[object] += bestValue - secondValue + epsilon;
+		if (objectOwner[object] != -1){
+			assignedEdge[objectOwner[object]] = -1;
+			biddersWaiting.push_back(objectOwner[object]);
+		}
+		objectOwner[object] = bidder;
+		assignedEdge[bidder] = bestEdge;
+	}
+}
@@ -0,0 +1,40 @@
+#ifndef _BATCH_ASSIGNMENT_H
+#define _BATCH_ASSIGNMENT_H
+#include <vector>
+#include <stddef.h>
+
+//Sparse assignment problem: bidders (vehicles) are matched to at most one object (request) each, through the edges added
+//for them, so that the total benefit is as high as possible. A bidder can also stay unmatched, which is worth nothing, so
+//only edges with a positive benefit are worth adding.
+//Solved with Bertsekas' auction algorithm: unmatched bidders bid for their best object, raising its price by how much they
+//prefer it to their next best choice. The total benefit found is within epsilon times the number of bidders of the best.
+class BatchAssignment
+{
+protected:
+	//Edges of bidder b are [bidderStart[b], bidderStart[b + 1]).
+	std::vector<int> bidderStart;
+	std::vector<int> edgeObject;
+	std::vector<float> edgeBenefit;
+	int objectCount;
+
+	std::vector<float> prices;
+	std::vector<int> objectOwner;
+	std::vector<int> assignedEdge;
+	std::vector<int> biddersWaiting;
+public:
+	BatchAssignment();
+
+	void clear();
+	//Starts the edges of the next bidder and returns its index.
+	int addBidder();
+	//Adds an edge from the last bidder added. Objects are numbered from 0.
+	void addEdge(int object, float benefit);
+
+	void solve(float epsilon);
+
+	size_t getBidderCount(){ return bidderStart.size() - 1; }
+	//Edge index the bidder was matched through, or -1.
+	int getAssignedEdge(int bidder){ return assignedEdge[bidder]; }
+};
+
+#endif
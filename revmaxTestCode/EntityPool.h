@@ -0,0 +1,68 @@
+#ifndef _ENTITY_POOL_H
+#define _ENTITY_POOL_H
+#include <vector>
+#include <new>
+#include <stddef.h>
+
+//Hands out objects carved from a few large blocks instead of one allocation each, and frees them all at once. Objects never
+//move once created, so pointers to them stay good until the pool is cleared.
+template<class T>
+class EntityPool
+{
+protected:
+	struct Block{
+		T* entities;
+		size_t capacity;
+		size_t used;
+	};
+	std::vector<Block> blocks;
+	size_t entityCount;
+
+	inline void addBlock(size_t capacity){
+		Block block;
+		block.entities = static_cast<T*>(::operator new(capacity * sizeof(T)));
+		block.capacity = capacity;
+		block.used = 0;
+		blocks.push_back(block);
+	}
+public:
+	EntityPool() : entityCount(0){}
+	~EntityPool(){ clear(); }
+	EntityPool(const EntityPool&) = delete;
+	EntityPool& operator=(const EntityPool&) = delete;
+
+	//Makes room for count more objects in a single block.
+	inline void reserve(size_t count){
+		if (blocks.empty() || blocks.back().capacity - blocks.back().used < count){
+			addBlock(count);
+		}
+	}
+
+	inline T* create(){
+		if (blocks.empty() || blocks.back().used == blocks.back().capacity){
+			//Each block is as large as all the ones before it, so a pool of n objects takes about log n blocks.
+			addBlock(entityCount < 64 ? 64 : entityCount);
+		}
+		Block& block = blocks.back();
+		T* entity = new (block.entities + block.used) T();
+		block.used++;
+		entityCount++;
+		return entity;
+	}
+
+	//Destroys every object and gives the blocks back.
+	inline void clear(){
+		for (Block& block : blocks){
+			for (size_t i = 0; i < block.used; i++){
+				block.entities[i].~T();
+			}
+			::operator delete(block.entities);
+		}
+		blocks.clear();
+		entityCount = 0;
+	}
+
+	size_t size(){ return entityCount; }
+};
+
+#endif
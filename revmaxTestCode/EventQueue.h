@@ -0,0 +1,40 @@
+#ifndef _EVENT_QUEUE_H
+#define _EVENT_QUEUE_H
+#include <queue>
+#include <vector>
+
+//A vehicle's next turn in an event driven test.
+struct VehicleEvent{
+	int time;
+	int vehicle;
+};
+
+//Hands out events in the order the tick loop would reach them: by time, then by the vehicle's place in the fleet.
+class EventQueue{
+protected:
+	struct LaterEvent{
+		bool operator()(const VehicleEvent& a, const VehicleEvent& b) const{
+			return a.time != b.time ? a.time > b.time : a.vehicle > b.vehicle;
+		}
+	};
+
+	std::priority_queue<VehicleEvent, std::vector<VehicleEvent>, LaterEvent> events;
+public:
+	inline void push(int time, int vehicle){
+		VehicleEvent event;
+		event.time = time;
+		event.vehicle = vehicle;
+		events.push(event);
+	}
+
+	inline VehicleEvent pop(){
+		VehicleEvent event = events.top();
+		events.pop();
+		return event;
+	}
+
+	inline const VehicleEvent& top(){ return events.top(); }
+	inline bool empty(){ return events.empty(); }
+};
+
+#endif
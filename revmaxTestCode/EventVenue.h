@@ -1,6 +1,6 @@
 #ifndef _EVENT_VENUE_H
 #define _EVENT_VENUE_H
-#include "RideRequest.h"
+#include "RideRequestStore.h"
 #include <map>
 
 class ShaderProgram;
@@ -0,0 +1,507 @@
+#include "ExcelStreamWriter.h"
+#include <string.h>
+#include <algorithm>
+
+//The workbook is a BIFF8 stream named "Workbook" in a compound file of 512 byte sectors. The stream is laid out in
+//sectors 0 onwards, so the rows can go to the file as they come. The sector tables and the directory follow the
+//stream, and are written again past its new end at each checkpoint.
+static const size_t SECTOR_SIZE = 512;
+static const size_t FAT_ENTRIES_PER_SECTOR = SECTOR_SIZE / 4;
+static const size_t HEADER_FAT_SECTORS = 109;
+static const uint32_t FREE_SECTOR = 0xFFFFFFFF;
+static const uint32_t END_OF_CHAIN = 0xFFFFFFFE;
+static const uint32_t FAT_SECTOR = 0xFFFFFFFD;
+static const uint32_t DIFAT_SECTOR = 0xFFFFFFFC;
+static const uint32_t NO_STREAM = 0xFFFFFFFF;
+//Smaller streams would have to go in the mini stream, so the workbook is padded out to this.
+static const size_t MINI_STREAM_CUTOFF = 4096;
+
+static const uint16_t BIFF_BOF = 0x0809;
+static const uint16_t BIFF_EOF = 0x000A;
+static const uint16_t BIFF_CODEPAGE = 0x0042;
+static const uint16_t BIFF_WINDOW1 = 0x003D;
+static const uint16_t BIFF_FONT = 0x0031;
+static const uint16_t BIFF_XF = 0x00E0;
+static const uint16_t BIFF_STYLE = 0x0293;
+static const uint16_t BIFF_BOUNDSHEET = 0x0085;
+static const uint16_t BIFF_SST = 0x00FC;
+static const uint16_t BIFF_EXTSST = 0x00FF;
+static const uint16_t BIFF_DIMENSIONS = 0x0200;
+static const uint16_t BIFF_WINDOW2 = 0x023E;
+static const uint16_t BIFF_LABELSST = 0x00FD;
+static const uint16_t BIFF_NUMBER = 0x0203;
+static const uint16_t BIFF_ROW = 0x0208;
+static const uint16_t BIFF_DBCELL = 0x00D7;
+static const size_t BIFF_MAX_RECORD_DATA = 8224;
+//Excel wants at least four fonts and the fifteen style formats before the format the cells use.
+static const size_t FONT_COUNT = 4;
+static const size_t STYLE_FORMAT_COUNT = 15;
+static const uint16_t CELL_FORMAT = STYLE_FORMAT_COUNT;
+
+static const size_t ROWS_PER_SHEET = 65536;
+static const size_t ROWS_PER_BLOCK = 32;
+static const size_t ROW_RECORD_SIZE = 20;
+static const size_t MAX_SHEET_NAME = 31;
+static const size_t CHECKPOINT_SIZE = 4 << 20;
+static const std::chrono::seconds CHECKPOINT_INTERVAL(1);
+//Rows held back behind an unfinished row before the rows after it go in anyway.
+static const size_t MAX_WAITING_ROWS = 1024;
+
+static void append8(std::string& out, uint8_t value){
+	out += (char)value;
+}
+
+static void append16(std::string& out, uint16_t value){
+	out += (char)(value & 0xFF);
+	out += (char)(value >> 8);
+}
+
+static void append32(std::string& out, uint32_t value){
+	append16(out, (uint16_t)(value & 0xFFFF));
+	append16(out, (uint16_t)(value >> 16));
+}
+
+static void appendDouble(std::string& out, double value){
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	append32(out, (uint32_t)(bits & 0xFFFFFFFF));
+	append32(out, (uint32_t)(bits >> 32));
+}
+
+static void appendRecordHeader(std::string& out, uint16_t type, size_t length){
+	append16(out, type);
+	append16(out, (uint16_t)length);
+}
+
+static void appendBof(std::string& out, uint16_t substreamType){
+	appendRecordHeader(out, BIFF_BOF, 16);
+	append16(out, 0x0600);
+	append16(out, substreamType);
+	append16(out, 0x0DBB);
+	append16(out, 0x07CC);
+	append32(out, 0);
+	append32(out, 6);
+}
+
+static void appendEof(std::string& out){
+	appendRecordHeader(out, BIFF_EOF, 0);
+}
+
+static void appendDimensions(std::string& out, size_t rows, size_t columns){
+	appendRecordHeader(out, BIFF_DIMENSIONS, 14);
+	append32(out, 0);
+	append32(out, (uint32_t)rows);
+	append16(out, 0);
+	append16(out, (uint16_t)columns);
+	append16(out, 0);
+}
+
+static void appendWindow2(std::string& out, bool selected){
+	appendRecordHeader(out, BIFF_WINDOW2, 18);
+	//Gridlines, headings, zeros, automatic grid color and outline symbols, and for the sheet shown first selected and active.
+	append16(out, selected ? 0x06B6 : 0x00B6);
+	append16(out, 0);
+	append16(out, 0);
+	append16(out, 0x0040);
+	append16(out, 0);
+	append16(out, 0);
+	append16(out, 0);
+	append32(out, 0);
+}
+
+static void appendDirectoryEntry(std::string& out, const char* name, uint8_t type, uint32_t child, uint32_t startSector, uint32_t size){
+	size_t nameLength = strlen(name);
+	for (size_t i = 0; i < 32; i++){
+		append16(out, i < nameLength ? (uint16_t)name[i] : 0);
+	}
+	append16(out, nameLength > 0 ? (uint16_t)((nameLength + 1) * 2) : 0);
+	append8(out, type);
+	//Black, which a tree of one entry must be.
+	append8(out, nameLength > 0 ? 1 : 0);
+	append32(out, NO_STREAM);
+	append32(out, NO_STREAM);
+	append32(out, child);
+	out.append(16 + 4 + 16, '\0');
+	append32(out, startSector);
+	append32(out, size);
+	append32(out, 0);
+}
+
+ExcelStreamWriter::~ExcelStreamWriter(){
+	try{
+		close();
+	}
+	catch (const char*){
+	}
+}
+
+std::string ExcelStreamWriter::getSheetName(size_t sheet){
+	return sheet == 0 ? sheetName : sheetName + " " + std::to_string(sheet + 1);
+}
+
+void ExcelStreamWriter::appendGlobals(){
+	appendBof(pending, 0x0005);
+
+	appendRecordHeader(pending, BIFF_CODEPAGE, 2);
+	append16(pending, 1200);
+
+	appendRecordHeader(pending, BIFF_WINDOW1, 18);
+	append16(pending, 0x01E0);
+	append16(pending, 0x005A);
+	append16(pending, 0x3FCF);
+	append16(pending, 0x2A4E);
+	append16(pending, 0x0038);
+	append16(pending, 0);
+	append16(pending, 0);
+	append16(pending, 1);
+	append16(pending, 0x0258);
+
+	for (size_t i = 0; i < FONT_COUNT; i++){
+		const char* fontName = "Arial";
+		appendRecordHeader(pending, BIFF_FONT, 16 + strlen(fontName));
+		append16(pending, 200);
+		append16(pending, 0);
+		append16(pending, 0x7FFF);
+		append16(pending, 400);
+		append16(pending, 0);
+		append8(pending, 0);
+		append8(pending, 0);
+		append8(pending, 0);
+		append8(pending, 0);
+		append8(pending, (uint8_t)strlen(fontName));
+		append8(pending, 0);
+		pending += fontName;
+	}
+
+	for (size_t i = 0; i <= STYLE_FORMAT_COUNT; i++){
+		bool styleFormat = i < STYLE_FORMAT_COUNT;
+		appendRecordHeader(pending, BIFF_XF, 20);
+		append16(pending, 0);
+		append16(pending, 0);
+		append16(pending, styleFormat ? 0xFFF5 : 0x0001);
+		append16(pending, 0x0020);
+		append16(pending, styleFormat ? 0xF400 : 0x0000);
+		append32(pending, 0);
+		append32(pending, 0);
+		append16(pending, 0x20C0);
+	}
+
+	appendRecordHeader(pending, BIFF_STYLE, 4);
+	append16(pending, 0x8000);
+	append8(pending, 0);
+	append8(pending, 0xFF);
+
+	for (size_t sheet = 0; sheet < sheetCount; sheet++){
+		std::string name = getSheetName(sheet);
+		appendRecordHeader(pending, BIFF_BOUNDSHEET, 8 + name.size());
+		sheetOffsetPositions.push_back(streamPosition());
+		append32(pending, 0);
+		append8(pending, 0);
+		append8(pending, 0);
+		append8(pending, (uint8_t)name.size());
+		append8(pending, 0);
+		pending += name;
+	}
+
+	//The column names are the only strings, shared by the header row of every sheet.
+	size_t sstLength = 8;
+	for (const std::string& name : columnNames){
+		sstLength += 3 + name.size();
+	}
+	if (sstLength > BIFF_MAX_RECORD_DATA){
+		throw "Column names too long for the results workbook!";
+	}
+	size_t sstPosition = streamPosition();
+	appendRecordHeader(pending, BIFF_SST, sstLength);
+	append32(pending, (uint32_t)(columnNames.size() * sheetCount));
+	append32(pending, (uint32_t)columnNames.size());
+	std::vector<std::pair<size_t, size_t>> buckets;
+	for (size_t i = 0; i < columnNames.size(); i++){
+		if (i % 8 == 0){
+			buckets.push_back(std::make_pair(streamPosition(), streamPosition() - sstPosition));
+		}
+		append16(pending, (uint16_t)columnNames[i].size());
+		append8(pending, 0);
+		pending += columnNames[i];
+	}
+	appendRecordHeader(pending, BIFF_EXTSST, 2 + 8 * buckets.size());
+	append16(pending, 8);
+	for (std::pair<size_t, size_t>& bucket : buckets){
+		append32(pending, (uint32_t)bucket.first);
+		append16(pending, (uint16_t)bucket.second);
+		append16(pending, 0);
+	}
+
+	appendEof(pending);
+}
+
+void ExcelStreamWriter::startSheet(){
+	bool firstSheet = sheetOffsets.empty();
+	sheetOffsets.push_back((uint32_t)streamPosition());
+	appendBof(pending, 0x0010);
+	rowCountPositions.push_back(streamPosition() + 8);
+	appendDimensions(pending, 1, columnNames.size());
+	appendWindow2(pending, firstSheet);
+	rowInSheet = 0;
+	for (size_t column = 0; column < columnNames.size(); column++){
+		appendRecordHeader(blockCells, BIFF_LABELSST, 10);
+		append16(blockCells, 0);
+		append16(blockCells, (uint16_t)column);
+		append16(blockCells, CELL_FORMAT);
+		append32(blockCells, (uint32_t)column);
+	}
+	endRow();
+}
+
+void ExcelStreamWriter::endRow(){
+	size_t rowStart = 0;
+	for (size_t size : blockRowSizes){
+		rowStart += size;
+	}
+	if (blockRowSizes.empty()){
+		blockFirstRow = rowInSheet;
+	}
+	blockRowSizes.push_back(blockCells.size() - rowStart);
+	rowInSheet++;
+	if (blockRowSizes.size() == ROWS_PER_BLOCK){
+		appendBlock(pending);
+		blockCells.clear();
+		blockRowSizes.clear();
+	}
+}
+
+void ExcelStreamWriter::appendBlock(std::string& out){
+	if (blockRowSizes.empty()){
+		return;
+	}
+	size_t blockStart = out.size();
+	for (size_t i = 0; i < blockRowSizes.size(); i++){
+		appendRecordHeader(out, BIFF_ROW, ROW_RECORD_SIZE - 4);
+		append16(out, (uint16_t)(blockFirstRow + i));
+		append16(out, 0);
+		append16(out, (uint16_t)columnNames.size());
+		append16(out, 0x00FF);
+		append16(out, 0);
+		append16(out, 0);
+		append16(out, 0x0100);
+		append16(out, CELL_FORMAT);
+	}
+	out += blockCells;
+	//Where the block's first row record is from here, then where each row's first cell is from the one before.
+	size_t dbcellStart = out.size();
+	appendRecordHeader(out, BIFF_DBCELL, 4 + 2 * blockRowSizes.size());
+	append32(out, (uint32_t)(dbcellStart - blockStart));
+	append16(out, (uint16_t)((blockRowSizes.size() - 1) * ROW_RECORD_SIZE));
+	for (size_t i = 1; i < blockRowSizes.size(); i++){
+		append16(out, (uint16_t)blockRowSizes[i - 1]);
+	}
+}
+
+void ExcelStreamWriter::appendRow(const std::vector<double>& values){
+	if (rowInSheet == ROWS_PER_SHEET){
+		if (sheetOffsets.size() == sheetCount){
+			throw "More rows than the results workbook was opened for!";
+		}
+		appendBlock(pending);
+		blockCells.clear();
+		blockRowSizes.clear();
+		appendEof(pending);
+		startSheet();
+	}
+	for (size_t column = 0; column < values.size() && column < columnNames.size(); column++){
+		appendRecordHeader(blockCells, BIFF_NUMBER, 14);
+		append16(blockCells, (uint16_t)rowInSheet);
+		append16(blockCells, (uint16_t)column);
+		append16(blockCells, CELL_FORMAT);
+		appendDouble(blockCells, values[column]);
+	}
+	endRow();
+}
+
+void ExcelStreamWriter::checkpoint(){
+	file.seekp(SECTOR_SIZE + streamSize);
+	file.write(pending.data(), pending.size());
+	streamSize += pending.size();
+	pending.clear();
+
+	//The rest of the workbook as it would end here: the rows of the block so far and the end of the current sheet,
+	//then the sheets no row has reached.
+	std::string tail;
+	std::vector<uint32_t> offsets = sheetOffsets;
+	appendBlock(tail);
+	appendEof(tail);
+	for (size_t sheet = sheetOffsets.size(); sheet < sheetCount; sheet++){
+		offsets.push_back((uint32_t)(streamSize + tail.size()));
+		appendBof(tail, 0x0010);
+		appendDimensions(tail, 0, 0);
+		appendWindow2(tail, false);
+		appendEof(tail);
+	}
+	size_t workbookSize = std::max(streamSize + tail.size(), MINI_STREAM_CUTOFF);
+	workbookSize = (workbookSize + SECTOR_SIZE - 1) / SECTOR_SIZE * SECTOR_SIZE;
+	tail.resize(workbookSize - streamSize, '\0');
+
+	//The sector tables cover their own sectors too, so their size is found by growing it until it stops changing.
+	size_t workbookSectors = workbookSize / SECTOR_SIZE;
+	size_t fatSectors = 0;
+	size_t difatSectors = 0;
+	while (true){
+		size_t totalSectors = workbookSectors + fatSectors + difatSectors + 1;
+		size_t neededFatSectors = (totalSectors + FAT_ENTRIES_PER_SECTOR - 1) / FAT_ENTRIES_PER_SECTOR;
+		size_t neededDifatSectors = neededFatSectors > HEADER_FAT_SECTORS ? (neededFatSectors - HEADER_FAT_SECTORS + FAT_ENTRIES_PER_SECTOR - 2) / (FAT_ENTRIES_PER_SECTOR - 1) : 0;
+		if (neededFatSectors == fatSectors && neededDifatSectors == difatSectors){
+			break;
+		}
+		fatSectors = neededFatSectors;
+		difatSectors = neededDifatSectors;
+	}
+	size_t firstFatSector = workbookSectors;
+	size_t firstDifatSector = firstFatSector + fatSectors;
+	size_t directorySector = firstDifatSector + difatSectors;
+
+	tail.reserve(tail.size() + (fatSectors + difatSectors + 1) * SECTOR_SIZE);
+	for (size_t sector = 0; sector < fatSectors * FAT_ENTRIES_PER_SECTOR; sector++){
+		if (sector + 1 < workbookSectors){
+			append32(tail, (uint32_t)(sector + 1));
+		}
+		else if (sector + 1 == workbookSectors || sector == directorySector){
+			append32(tail, END_OF_CHAIN);
+		}
+		else if (sector >= firstFatSector && sector < firstDifatSector){
+			append32(tail, FAT_SECTOR);
+		}
+		else if (sector >= firstDifatSector && sector < directorySector){
+			append32(tail, DIFAT_SECTOR);
+		}
+		else{
+			append32(tail, FREE_SECTOR);
+		}
+	}
+	for (size_t sector = 0; sector < difatSectors; sector++){
+		for (size_t i = 0; i < FAT_ENTRIES_PER_SECTOR - 1; i++){
+			size_t fatSector = HEADER_FAT_SECTORS + sector * (FAT_ENTRIES_PER_SECTOR - 1) + i;
+			append32(tail, fatSector < fatSectors ? (uint32_t)(firstFatSector + fatSector) : FREE_SECTOR);
+		}
+		append32(tail, sector + 1 < difatSectors ? (uint32_t)(firstDifatSector + sector + 1) : END_OF_CHAIN);
+	}
+	appendDirectoryEntry(tail, "Root Entry", 5, 1, END_OF_CHAIN, 0);
+	appendDirectoryEntry(tail, "Workbook", 2, NO_STREAM, 0, (uint32_t)workbookSize);
+	appendDirectoryEntry(tail, "", 0, NO_STREAM, 0, 0);
+	appendDirectoryEntry(tail, "", 0, NO_STREAM, 0, 0);
+	file.write(tail.data(), tail.size());
+
+	for (size_t sheet = 0; sheet < sheetCount; sheet++){
+		std::string offset;
+		append32(offset, offsets[sheet]);
+		file.seekp(SECTOR_SIZE + sheetOffsetPositions[sheet]);
+		file.write(offset.data(), offset.size());
+	}
+	for (size_t sheet = 0; sheet < rowCountPositions.size(); sheet++){
+		std::string rows;
+		append32(rows, (uint32_t)(sheet + 1 < rowCountPositions.size() ? ROWS_PER_SHEET : rowInSheet));
+		file.seekp(SECTOR_SIZE + rowCountPositions[sheet]);
+		file.write(rows.data(), rows.size());
+	}
+
+	std::string header("\xD0\xCF\x11\xE0\xA1\xB1\x1A\xE1", 8);
+	header.append(16, '\0');
+	append16(header, 0x003E);
+	append16(header, 3);
+	append16(header, 0xFFFE);
+	append16(header, 9);
+	append16(header, 6);
+	header.append(6, '\0');
+	append32(header, 0);
+	append32(header, (uint32_t)fatSectors);
+	append32(header, (uint32_t)directorySector);
+	append32(header, 0);
+	append32(header, (uint32_t)MINI_STREAM_CUTOFF);
+	append32(header, END_OF_CHAIN);
+	append32(header, 0);
+	append32(header, difatSectors > 0 ? (uint32_t)firstDifatSector : END_OF_CHAIN);
+	append32(header, (uint32_t)difatSectors);
+	for (size_t i = 0; i < HEADER_FAT_SECTORS; i++){
+		append32(header, i < fatSectors ? (uint32_t)(firstFatSector + i) : FREE_SECTOR);
+	}
+	file.seekp(0);
+	file.write(header.data(), header.size());
+	file.flush();
+	if (file.fail()){
+		failed = true;
+	}
+	lastCheckpoint = std::chrono::steady_clock::now();
+}
+
+void ExcelStreamWriter::open(const std::string& filePath, const std::string& sheetName, const std::vector<const char*>& columnNames, size_t rowCount){
+	this->columnNames.assign(columnNames.begin(), columnNames.end());
+	this->sheetName = sheetName;
+	sheetCount = std::max<size_t>(1, (rowCount + ROWS_PER_SHEET - 2) / (ROWS_PER_SHEET - 1));
+	if (this->columnNames.size() > 256 || getSheetName(sheetCount - 1).size() > MAX_SHEET_NAME){
+		throw "Too many results for the results workbook!";
+	}
+	file.open(filePath.c_str(), std::ios::binary | std::ios::trunc);
+	if (!file.is_open()){
+		throw "Could not write the results workbook!";
+	}
+	failed = false;
+	pending.clear();
+	streamSize = 0;
+	sheetOffsetPositions.clear();
+	sheetOffsets.clear();
+	rowCountPositions.clear();
+	blockCells.clear();
+	blockRowSizes.clear();
+	waitingRows.clear();
+	nextRow = 0;
+	appendGlobals();
+	startSheet();
+	//Even a sweep that dies before its first test finishes leaves a workbook with the header row.
+	checkpoint();
+}
+
+void ExcelStreamWriter::addRow(size_t rowIndex, const std::vector<double>& values){
+	std::lock_guard<std::mutex> guard(lock);
+	if (rowIndex < nextRow){
+		//Its place was given up to the rows after it.
+		appendRow(values);
+	}
+	else if (rowIndex != nextRow){
+		waitingRows[rowIndex] = values;
+		if (waitingRows.size() <= MAX_WAITING_ROWS){
+			return;
+		}
+		nextRow = waitingRows.begin()->first;
+	}
+	else{
+		appendRow(values);
+		nextRow++;
+	}
+	std::map<size_t, std::vector<double>>::iterator waiting;
+	while ((waiting = waitingRows.begin()) != waitingRows.end() && waiting->first == nextRow){
+		appendRow(waiting->second);
+		waitingRows.erase(waiting);
+		nextRow++;
+	}
+	if (pending.size() >= CHECKPOINT_SIZE || std::chrono::steady_clock::now() - lastCheckpoint >= CHECKPOINT_INTERVAL){
+		checkpoint();
+	}
+}
+
+void ExcelStreamWriter::close(){
+	std::lock_guard<std::mutex> guard(lock);
+	if (!file.is_open()){
+		return;
+	}
+	//Rows behind a test that never finished still go in, after the rows before the gap.
+	for (std::pair<const size_t, std::vector<double>>& waiting : waitingRows){
+		appendRow(waiting.second);
+	}
+	waitingRows.clear();
+	checkpoint();
+	file.close();
+	std::string().swap(pending);
+	std::string().swap(blockCells);
+	if (failed || file.fail()){
+		throw "Could not write the results workbook!";
+	}
+}
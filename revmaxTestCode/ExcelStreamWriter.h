@@ -0,0 +1,73 @@
+#ifndef _EXCEL_STREAM_WRITER_H
+#define _EXCEL_STREAM_WRITER_H
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <mutex>
+#include <chrono>
+#include <stdint.h>
+#include <stddef.h>
+
+//Writes an .xls workbook of numeric rows under a header row straight to the file as the rows come in, so a sweep's
+//spreadsheet never has to sit in memory. Only the rows since the last checkpoint are held. At each checkpoint the file
+//is made a complete workbook of every row written so far, so a sweep that dies part way leaves a spreadsheet of the tests
+//it finished, less any still held back behind an unfinished one. A sheet holds 65,535 rows under its header; further rows
+//go to sheets named after the first with a number.
+class ExcelStreamWriter
+{
+protected:
+	std::mutex lock;
+	std::ofstream file;
+	std::vector<std::string> columnNames;
+	std::string sheetName;
+	size_t sheetCount;
+
+	//Workbook stream bytes not yet in the file, which start at stream offset streamSize.
+	std::string pending;
+	size_t streamSize;
+	//Where the sheet offset of each sheet's entry in the workbook globals sits in the stream.
+	std::vector<size_t> sheetOffsetPositions;
+	std::vector<uint32_t> sheetOffsets;
+	//Where the row count of each started sheet sits in the stream, patched like the sheet offsets.
+	std::vector<size_t> rowCountPositions;
+	size_t rowInSheet;
+	//The cells of the rows of the current block of up to 32 rows, which goes out whole with its row records.
+	std::string blockCells;
+	std::vector<size_t> blockRowSizes;
+	size_t blockFirstRow;
+	//Rows that finished ahead of a row before them, by row index, and the index of the next row to write. Rows before
+	//nextRow that were never written come in after it was moved past them.
+	std::map<size_t, std::vector<double>> waitingRows;
+	size_t nextRow;
+	std::chrono::steady_clock::time_point lastCheckpoint;
+	bool failed;
+
+	size_t streamPosition(){ return streamSize + pending.size(); }
+	std::string getSheetName(size_t sheet);
+	void appendGlobals();
+	void startSheet();
+	//Ends the row whose cells were just added to the block, and writes the block once it is full.
+	void endRow();
+	void appendBlock(std::string& out);
+	void appendRow(const std::vector<double>& values);
+	//Writes the pending bytes and then everything that makes the file a whole workbook after them.
+	void checkpoint();
+public:
+	ExcelStreamWriter() : sheetCount(0), streamSize(0), rowInSheet(0), blockFirstRow(0), nextRow(0), failed(false){}
+	~ExcelStreamWriter();
+	ExcelStreamWriter(const ExcelStreamWriter&) = delete;
+	ExcelStreamWriter& operator=(const ExcelStreamWriter&) = delete;
+
+	//Starts the workbook with room for rowCount rows of the given columns.
+	void open(const std::string& filePath, const std::string& sheetName, const std::vector<const char*>& columnNames, size_t rowCount);
+	bool isOpen(){ return file.is_open(); }
+	//Adds the row with the given index. Rows may come in any order and from any thread, and go into the workbook in
+	//index order, except that at most 1,024 rows wait for an unfinished row before them. Past that the waiting rows go in
+	//up to the next gap, and the missing rows go in wherever they are when they arrive.
+	void addRow(size_t rowIndex, const std::vector<double>& values);
+	//Writes any rows still waiting in index order and closes the file. Throws if any write failed.
+	void close();
+};
+
+#endif
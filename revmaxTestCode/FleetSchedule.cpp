@@ -0,0 +1,32 @@
+#include "FleetSchedule.h"
+#include <algorithm>
+
+FleetSchedule::FleetSchedule(size_t fleetSize)
+{
+	for (size_t i = 0; i < fleetSize; i++){
+		idleVehicles.insert(idleVehicles.end(), i);
+	}
+}
+
+void FleetSchedule::setIdle(int vehicle){
+	idleVehicles.insert(vehicle);
+}
+
+void FleetSchedule::setBusy(int vehicle, int dueTime){
+	idleVehicles.erase(vehicle);
+	if (dueTime != -1){
+		tripEvents.push(dueTime, vehicle);
+	}
+}
+
+void FleetSchedule::getVehiclesDue(int time, std::vector<int>& vehicles){
+	vehicles.clear();
+	while (!tripEvents.empty() && tripEvents.top().time <= time){
+		vehicles.push_back(tripEvents.pop().vehicle);
+	}
+	size_t dueCount = vehicles.size();
+	std::sort(vehicles.begin(), vehicles.end());
+	vehicles.insert(vehicles.end(), idleVehicles.begin(), idleVehicles.end());
+	std::inplace_merge(vehicles.begin(), vehicles.begin() + dueCount, vehicles.end());
+	vehicles.erase(std::unique(vehicles.begin(), vehicles.end()), vehicles.end());
+}
@@ -0,0 +1,32 @@
+#ifndef _FLEET_SCHEDULE_H
+#define _FLEET_SCHEDULE_H
+#include <set>
+#include <vector>
+#include <stddef.h>
+#include "EventQueue.h"
+
+//Tracks which vehicles of a fleet can change on a given tick: idle vehicles, which search for a request every tick, and busy
+//vehicles whose next pickup or drop-off falls on that tick. Busy vehicles in between are left alone. Vehicles are identified
+//by their place in the fleet.
+class FleetSchedule
+{
+protected:
+	std::set<int> idleVehicles;
+	//Busy vehicles by the tick of their next pickup or drop-off.
+	EventQueue tripEvents;
+public:
+	//Every vehicle starts out idle.
+	FleetSchedule(size_t fleetSize);
+
+	void setIdle(int vehicle);
+	//A due time of -1 means the vehicle's trip will not change again.
+	void setBusy(int vehicle, int dueTime);
+
+	//Fills vehicles with every idle vehicle and every busy one due on this tick, in fleet order.
+	//Ticks must be asked for in increasing order.
+	void getVehiclesDue(int time, std::vector<int>& vehicles);
+
+	const std::set<int>& getIdleVehicles(){ return idleVehicles; }
+};
+
+#endif
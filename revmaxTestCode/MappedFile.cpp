@@ -0,0 +1,89 @@
+#include "MappedFile.h"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& filePath) : data(nullptr), size(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+{
+	fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE){
+		throw "Could not open the file!";
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize)){
+		CloseHandle(fileHandle);
+		throw "Could not open the file!";
+	}
+	size = (size_t)fileSize.QuadPart;
+	//An empty file cannot be mapped, and needs no mapping.
+	if (size == 0){
+		return;
+	}
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle != nullptr){
+		data = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	}
+	if (data == nullptr){
+		if (mappingHandle != nullptr){
+			CloseHandle(mappingHandle);
+		}
+		CloseHandle(fileHandle);
+		throw "Could not map the file!";
+	}
+}
+
+MappedFile::~MappedFile()
+{
+	if (data != nullptr){
+		UnmapViewOfFile(data);
+	}
+	if (mappingHandle != nullptr){
+		CloseHandle(mappingHandle);
+	}
+	if (fileHandle != INVALID_HANDLE_VALUE){
+		CloseHandle(fileHandle);
+	}
+}
+#else
+MappedFile::MappedFile(const std::string& filePath) : data(nullptr), size(0)
+{
+	int file = open(filePath.c_str(), O_RDONLY);
+	if (file == -1){
+		throw "Could not open the file!";
+	}
+	struct stat fileStatus;
+	if (fstat(file, &fileStatus) == -1){
+		close(file);
+		throw "Could not open the file!";
+	}
+	size = (size_t)fileStatus.st_size;
+	//An empty file cannot be mapped, and needs no mapping.
+	if (size == 0){
+		close(file);
+		return;
+	}
+	void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+	//The mapping keeps the file open.
+	close(file);
+	if (mapping == MAP_FAILED){
+		throw "Could not map the file!";
+	}
+	madvise(mapping, size, MADV_SEQUENTIAL);
+	data = (const char*)mapping;
+}
+
+MappedFile::~MappedFile()
+{
+	if (data != nullptr){
+		munmap((void*)data, size);
+	}
+}
+#endif
@@ -0,0 +1,28 @@
+#ifndef _MAPPED_FILE_H
+#define _MAPPED_FILE_H
+#include <string>
+#include <stddef.h>
+
+//A file mapped read only into memory. Pages are read in as they are first touched and can be dropped again under memory
+//pressure, so reading a large file front to back holds little of it at once.
+class MappedFile
+{
+protected:
+	const char* data;
+	size_t size;
+#ifdef _WIN32
+	void* fileHandle;
+	void* mappingHandle;
+#endif
+public:
+	MappedFile(const std::string& filePath);
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const char* begin(){ return data; }
+	const char* end(){ return data + size; }
+	size_t getSize(){ return size; }
+};
+
+#endif
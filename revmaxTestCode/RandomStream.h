@@ -0,0 +1,81 @@
+#ifndef _RANDOM_STREAM_H
+#define _RANDOM_STREAM_H
+#include <stdint.h>
+
+//xoshiro256** random numbers. A seed picks a sequence 2^256 - 1 numbers long, and stream n of a seed starts 2^128 numbers
+//after stream n - 1, so streams never overlap: each test draws from its own stream, and what it draws depends only on the
+//seed and its stream number, not on what other tests draw or in which order they are set up.
+class RandomStream
+{
+protected:
+	uint64_t state[4];
+
+	static inline uint64_t rotateLeft(uint64_t x, int k){
+		return (x << k) | (x >> (64 - k));
+	}
+
+public:
+	//Moves the stream 2^128 numbers ahead, to the start of the next stream of its seed.
+	inline void jump(){
+		static const uint64_t jumpPolynomial[4] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+		uint64_t jumped[4] = { 0, 0, 0, 0 };
+		for (int word = 0; word < 4; word++){
+			for (int bit = 0; bit < 64; bit++){
+				if (jumpPolynomial[word] & ((uint64_t)1 << bit)){
+					for (int i = 0; i < 4; i++){
+						jumped[i] ^= state[i];
+					}
+				}
+				next();
+			}
+		}
+		for (int i = 0; i < 4; i++){
+			state[i] = jumped[i];
+		}
+	}
+
+	RandomStream(uint64_t seed = 0, unsigned stream = 0){
+		//The state is filled from the seed with splitmix64, which never leaves it all zero.
+		for (int i = 0; i < 4; i++){
+			seed += 0x9e3779b97f4a7c15ULL;
+			uint64_t mixed = seed;
+			mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebULL;
+			state[i] = mixed ^ (mixed >> 31);
+		}
+		for (unsigned i = 0; i < stream; i++){
+			jump();
+		}
+	}
+
+	inline uint64_t next(){
+		uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+		uint64_t shifted = state[1] << 17;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= shifted;
+		state[3] = rotateLeft(state[3], 45);
+		return result;
+	}
+
+	//Uniform in [bottom, top).
+	inline float nextFloat(float bottom, float top){
+		//The top 53 bits give every double in [0, 1) that is a multiple of 2^-53.
+		double unit = (next() >> 11) * (1.0 / 9007199254740992.0);
+		return (float)(bottom + unit * ((double)top - bottom));
+	}
+
+	//Uniform over the integers in [bottom, top), or bottom when the range is empty.
+	inline int nextInt(int bottom, int top){
+		if (top <= bottom){
+			return bottom;
+		}
+		uint64_t range = (uint64_t)((int64_t)top - bottom);
+		//Scaling the top 32 bits is off from uniform by at most range / 2^32, which no test's ranges come near.
+		return (int)(bottom + (int64_t)(((next() >> 32) * range) >> 32));
+	}
+};
+
+#endif
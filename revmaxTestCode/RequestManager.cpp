@@ -1,13 +1,7 @@
 #include "RequestManager.h"
-#include "RideRequest.h"
 //#include "EventVenue.h"
-#include "Texture.h"
-#include "ShaderProgram.h"
 #include "mathHelper.h"
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846264338327950288419
-#endif
+#include <algorithm>
 
 
 RequestManager::RequestManager()
@@ -24,11 +18,10 @@ RequestManager::~RequestManager()
 
 void RequestManager::initializeRequestMap(){
 	normalizeCoordinates();
-	for (int i = latitudeMin; i <= latitudeMax; i += sectionRadius){
-		for (int j = longitudeMin; j <= longitudeMax; j += sectionRadius){
-			requestMap[i][j] = {};
-		}
-	}
+	//One cell per section, plus a trailing cell when a maximum is not a multiple of the section radius.
+	gridRows = (latitudeMax - latitudeMin + sectionRadius - 1) / sectionRadius + 1;
+	gridColumns = (longitudeMax - longitudeMin + sectionRadius - 1) / sectionRadius + 1;
+	indexRequests();
 }
 
 void RequestManager::normalizeCoordinates(){
@@ -47,22 +40,27 @@ void RequestManager::normalizeCoordinates(){
 	}
 }
 
-void RequestManager::addRequest(RideRequest* request){
-	int latitudeToUse = (int)request->getLocation().first;
-	int longitudeToUse = (int)request->getLocation().second;
-	if (latitudeToUse % sectionRadius > sectionRadius / 2){
-		latitudeToUse += sectionRadius - (latitudeToUse % sectionRadius);
+int RequestManager::snapToSection(int coordinate){
+	if (coordinate % sectionRadius > sectionRadius / 2){
+		coordinate += sectionRadius - (coordinate % sectionRadius);
 	}
-	else if (latitudeToUse % sectionRadius <= sectionRadius / 2){
-		latitudeToUse -= latitudeToUse % sectionRadius;
+	else if (coordinate % sectionRadius <= sectionRadius / 2){
+		coordinate -= coordinate % sectionRadius;
 	}
+	return coordinate;
+}
 
-	if (longitudeToUse % sectionRadius > sectionRadius / 2){
-		longitudeToUse += sectionRadius - (longitudeToUse % sectionRadius);
-	}
-	else if (longitudeToUse % sectionRadius <= sectionRadius / 2){
-		longitudeToUse -= longitudeToUse % sectionRadius;
-	}
+int RequestManager::getCellIndex(int latitude, int longitude){
+	//Both coordinates must already be snapped and inside the bounds; a maximum that is not a multiple
+	//of the section radius rounds up into the trailing cell.
+	int row = (latitude - latitudeMin + sectionRadius - 1) / sectionRadius;
+	int column = (longitude - longitudeMin + sectionRadius - 1) / sectionRadius;
+	return row * gridColumns + column;
+}
+
+int RequestManager::getCellIndex(std::pair<long, long> location){
+	int latitudeToUse = snapToSection((int)location.first);
+	int longitudeToUse = snapToSection((int)location.second);
 
 	if (latitudeToUse < latitudeMin){
 		latitudeToUse = latitudeMin;
@@ -78,8 +76,107 @@ void RequestManager::addRequest(RideRequest* request){
 		longitudeToUse = longitudeMax;
 	}
 
-	requestMap[latitudeToUse][longitudeToUse].push_back(request);
-	allRideRequests.push_back(request);
+	return getCellIndex(latitudeToUse, longitudeToUse);
+}
+
+RequestId RequestManager::addRequest(std::pair<long, long> location, std::pair<long, long> destination, int requestTime){
+	return rideRequests.addRequest(location, destination, requestTime);
+}
+
+void RequestManager::indexRequests(){
+	//Counting the requests of each section first sizes every slice exactly, so the whole index takes one allocation per array.
+	size_t cellCount = gridRows * gridColumns;
+	size_t requestCount = rideRequests.size();
+	sectionStarts.assign(cellCount + 1, 0);
+	for (RequestId request = 0; request < (RequestId)requestCount; request++){
+		int cellIndex = getCellIndex(rideRequests.getLocation(request));
+		rideRequests.setCellIndex(request, cellIndex);
+		sectionStarts[cellIndex + 1]++;
+	}
+	for (size_t cellIndex = 0; cellIndex < cellCount; cellIndex++){
+		sectionStarts[cellIndex + 1] += sectionStarts[cellIndex];
+	}
+	sectionRequests.resize(requestCount);
+	sectionRequestTimes.resize(requestCount);
+	unmatchedRequests.resize(requestCount);
+	unmatchedCounts.assign(cellCount, 0);
+	//Sections fill in request order, so the order of each section's requests is the order they were added in.
+	std::vector<int> filled(sectionStarts.begin(), sectionStarts.end() - 1);
+	for (RequestId request = 0; request < (RequestId)requestCount; request++){
+		int slot = filled[rideRequests.getCellIndex(request)]++;
+		sectionRequests[slot] = request;
+		sectionRequestTimes[slot] = rideRequests.getRequestTime(request);
+		if (!rideRequests.getMatchedToVehicle(request)){
+			addUnmatchedRequest(request);
+		}
+		else{
+			rideRequests.setUnmatchedIndex(request, -1);
+		}
+	}
+	for (size_t cellIndex = 0; cellIndex < cellCount; cellIndex++){
+		std::sort(sectionRequestTimes.begin() + sectionStarts[cellIndex], sectionRequestTimes.begin() + sectionStarts[cellIndex + 1]);
+	}
+}
+
+void RequestManager::setRequestTime(RequestId request, int time){
+	int previousTime = rideRequests.getRequestTime(request);
+	rideRequests.setRequestTime(request, time);
+	if (previousTime != time){
+		updateRequestTime(request, previousTime);
+	}
+}
+
+void RequestManager::setMatchedToVehicle(RequestId request, bool matchedToVehicle){
+	bool wasMatched = rideRequests.getMatchedToVehicle(request);
+	rideRequests.setMatchedToVehicle(request, matchedToVehicle);
+	if (wasMatched != matchedToVehicle){
+		if (matchedToVehicle){
+			removeUnmatchedRequest(request);
+		}
+		else{
+			addUnmatchedRequest(request);
+		}
+	}
+}
+
+void RequestManager::addUnmatchedRequest(RequestId request){
+	int cellIndex = rideRequests.getCellIndex(request);
+	int unmatchedIndex = sectionStarts[cellIndex] + unmatchedCounts[cellIndex]++;
+	rideRequests.setUnmatchedIndex(request, unmatchedIndex);
+	unmatchedRequests[unmatchedIndex] = request;
+}
+
+void RequestManager::removeUnmatchedRequest(RequestId request){
+	//Swap with the last open request of the section and shrink the section, so matching a request is constant time.
+	int cellIndex = rideRequests.getCellIndex(request);
+	RequestId last = unmatchedRequests[sectionStarts[cellIndex] + --unmatchedCounts[cellIndex]];
+	unmatchedRequests[rideRequests.getUnmatchedIndex(request)] = last;
+	rideRequests.setUnmatchedIndex(last, rideRequests.getUnmatchedIndex(request));
+	rideRequests.setUnmatchedIndex(request, -1);
+}
+
+void RequestManager::updateRequestTime(RequestId request, int previousTime){
+	int cellIndex = rideRequests.getCellIndex(request);
+	std::vector<int>::iterator begin = sectionRequestTimes.begin() + sectionStarts[cellIndex];
+	std::vector<int>::iterator end = sectionRequestTimes.begin() + sectionStarts[cellIndex + 1];
+	std::vector<int>::iterator previous = std::lower_bound(begin, end, previousTime);
+	if (previous == end || *previous != previousTime){
+		throw "Request time missing from its section!";
+	}
+	//Overwrite the old time and slide the new one into place; the section keeps its size.
+	*previous = rideRequests.getRequestTime(request);
+	for (; previous + 1 != end && *(previous + 1) < *previous; previous++){
+		std::iter_swap(previous, previous + 1);
+	}
+	for (; previous != begin && *(previous - 1) > *previous; previous--){
+		std::iter_swap(previous, previous - 1);
+	}
+}
+
+int RequestManager::countRequestsInCell(int cellIndex, int timeBegin, int timeEnd){
+	std::vector<int>::iterator begin = sectionRequestTimes.begin() + sectionStarts[cellIndex];
+	std::vector<int>::iterator end = sectionRequestTimes.begin() + sectionStarts[cellIndex + 1];
+	return std::upper_bound(begin, end, timeEnd) - std::lower_bound(begin, end, timeBegin);
 }
 
 //void RequestManager::addVenue(EventVenue* venue){
@@ -102,40 +199,53 @@ void RequestManager::addRequest(RideRequest* request){
 //	allVenues.push_back(venue);
 //}
 
-std::vector<RideRequest*>& RequestManager::getRequestsAtLocation(std::pair<long, long> location){
-	int latitudeToUse = (int)location.first;
-	int longitudeToUse = (int)location.second;
-
+void RequestManager::getRequestsAtLocation(std::pair<long, long> location, std::vector<RequestId>& requests){
 	//This could later be re-worked into ranged SQL queries.
-	if (latitudeToUse % sectionRadius > sectionRadius / 2){
-		latitudeToUse += sectionRadius - (latitudeToUse % sectionRadius);
-	}
-	else if (latitudeToUse % sectionRadius <= sectionRadius / 2){
-		latitudeToUse -= latitudeToUse % sectionRadius;
-	}
+	int cellIndex = getCellIndex(location);
+	requests.insert(requests.end(), sectionRequests.begin() + sectionStarts[cellIndex], sectionRequests.begin() + sectionStarts[cellIndex + 1]);
+}
 
-	if (longitudeToUse % sectionRadius > sectionRadius / 2){
-		longitudeToUse += sectionRadius - (longitudeToUse % sectionRadius);
-	}
-	else if (longitudeToUse % sectionRadius <= sectionRadius / 2){
-		longitudeToUse -= longitudeToUse % sectionRadius;
-	}
+std::pair<int, int> RequestManager::getSection(std::pair<long, long> location){
+	int cellIndex = getCellIndex(location);
+	return std::make_pair(cellIndex / gridColumns, cellIndex % gridColumns);
+}
 
-	if (latitudeToUse < latitudeMin){
-		latitudeToUse = latitudeMin;
-	}
-	else if (latitudeToUse > latitudeMax){
-		latitudeToUse = latitudeMax;
-	}
+int RequestManager::getRingForRadius(float radius){
+	return snapToSection((int)radius) / sectionRadius;
+}
 
-	if (longitudeToUse < longitudeMin){
-		longitudeToUse = longitudeMin;
+//Appends every unmatched request in the sections whose distance (in sections, diagonals included) from the
+//location's section is between innerRing and outerRing. Each section is visited once, so widening a search
+//ring by ring never revisits a section.
+void RequestManager::getRequestsInRing(std::pair<long, long> location, int innerRing, int outerRing, std::vector<RequestId>& candidates){
+	int centerCell = getCellIndex(location);
+	int centerRow = centerCell / gridColumns;
+	int centerColumn = centerCell % gridColumns;
+	if (innerRing < 0){
+		innerRing = 0;
 	}
-	else if (longitudeToUse > longitudeMax){
-		longitudeToUse = longitudeMax;
+	for (int ring = innerRing; ring <= outerRing; ring++){
+		int rowBegin = std::max(centerRow - ring, 0);
+		int rowEnd = std::min(centerRow + ring, gridRows - 1);
+		for (int row = rowBegin; row <= rowEnd; row++){
+			//Rows on the edge of the ring are walked in full, the rows between only contribute their two ends.
+			bool edgeRow = row == centerRow - ring || row == centerRow + ring;
+			int columnStep = edgeRow || ring == 0 ? 1 : 2 * ring;
+			int columnBegin = centerColumn - ring;
+			int columnEnd = std::min(centerColumn + ring, gridColumns - 1);
+			if (edgeRow && columnBegin < 0){
+				columnBegin = 0;
+			}
+			for (int column = columnBegin; column <= columnEnd; column += columnStep){
+				if (column < 0){
+					continue;
+				}
+				int cellIndex = row * gridColumns + column;
+				std::vector<RequestId>::iterator unmatched = unmatchedRequests.begin() + sectionStarts[cellIndex];
+				candidates.insert(candidates.end(), unmatched, unmatched + unmatchedCounts[cellIndex]);
+			}
+		}
 	}
-
-	return requestMap[latitudeToUse][longitudeToUse];
 }
 
 void RequestManager::setSectionRadius(int sectionRadius){
@@ -166,30 +276,18 @@ std::pair<int, int> RequestManager::getMaxCoords(){
 	return std::make_pair(latitudeMax, longitudeMax);
 }
 
-int RequestManager::getNumberOfRequestsAtLocation(std::pair<long, long> location, int time, int timeRadius){
-	int latitudeToUse = (int)location.first;
-	int longitudeToUse = (int)location.second;
+int RequestManager::getNumberOfRequestsAtLocation(std::pair<long, long> location, int time){
+	int latitudeToUse = snapToSection((int)location.first);
+	int longitudeToUse = snapToSection((int)location.second);
 	int requestCount = 0;
 
-	//This could later be re-worked into ranged SQL queries.
-	if (latitudeToUse % sectionRadius > sectionRadius / 2){
-		latitudeToUse += sectionRadius - (latitudeToUse % sectionRadius);
-	}
-	else if (latitudeToUse % sectionRadius <= sectionRadius / 2){
-		latitudeToUse -= latitudeToUse % sectionRadius;
+	//Destinations are not clamped to the map: a section outside of it never holds requests.
+	if (latitudeToUse < latitudeMin || latitudeToUse > latitudeMax || longitudeToUse < longitudeMin || longitudeToUse > longitudeMax){
+		return 0;
 	}
 
-	if (longitudeToUse % sectionRadius > sectionRadius / 2){
-		longitudeToUse += sectionRadius - (longitudeToUse % sectionRadius);
-	}
-	else if (longitudeToUse % sectionRadius <= sectionRadius / 2){
-		longitudeToUse -= longitudeToUse % sectionRadius;
-	}
-	for (size_t i = 0; i < requestMap[latitudeToUse][longitudeToUse].size(); i++){
-		if (requestMap[latitudeToUse][longitudeToUse][i]->getRequestTime() == time){
-			requestCount++;
-		}
-	}
+	//This could later be re-worked into ranged SQL queries.
+	requestCount = countRequestsInCell(getCellIndex(latitudeToUse, longitudeToUse), time, time);
 
 	//for (size_t i = 0; i < venueMap[latitudeToUse][longitudeToUse].size(); i++){
 	//	requestCount += venueMap[latitudeToUse][longitudeToUse][i]->getProjectedRequests(time, timeRadius);
@@ -210,181 +308,22 @@ void RequestManager::setRequestTexture(Texture* texture){
 //	venueTexture = texture;
 //}
 
-void RequestManager::render(ShaderProgram* program, float time, float timeRadius, float scaleX, float scaleY){
-	std::vector<GLfloat> objectVertices;
-	std::vector<GLfloat> textureCoordinates;
-	for (int i = longitudeMin; i <= longitudeMax; i += sectionRadius){
-		for (int j = latitudeMin; j <= latitudeMax; j += sectionRadius){
-			modelMatrix.identity();
-			modelMatrix.Translate(i, j, 0);
-			modelMatrix.Scale(sectionRadius, 0.25, 0);
-			objectVertices = { -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f };
-
-			textureCoordinates = gridTexture->getTextureCoordinates();
-			glBindTexture(GL_TEXTURE_2D, gridTexture->getTextureID());
-			program->setModelMatrix(modelMatrix);
-
-			glEnableVertexAttribArray(program->positionAttribute);
-			glVertexAttribPointer(program->positionAttribute, 2, GL_FLOAT, false, 0, objectVertices.data());
-
-			glEnableVertexAttribArray(program->texCoordAttribute);
-			glVertexAttribPointer(program->texCoordAttribute, 2, GL_FLOAT, false, 0, textureCoordinates.data());
-
-			glDrawArrays(GL_TRIANGLES, 0, 6);
-			glDisableVertexAttribArray(program->positionAttribute);
-			glDisableVertexAttribArray(program->texCoordAttribute);
-
-			modelMatrix.setScale(1, 1, 0);
-			//modelMatrix.Translate(sectionRadius, 0, 0);
-			modelMatrix.setScale(0.5, sectionRadius, 0);
-			objectVertices = { -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f };
-
-			textureCoordinates = gridTexture->getTextureCoordinates();
-			glBindTexture(GL_TEXTURE_2D, gridTexture->getTextureID());
-			program->setModelMatrix(modelMatrix);
-
-			glEnableVertexAttribArray(program->positionAttribute);
-			glVertexAttribPointer(program->positionAttribute, 2, GL_FLOAT, false, 0, objectVertices.data());
-
-			glEnableVertexAttribArray(program->texCoordAttribute);
-			glVertexAttribPointer(program->texCoordAttribute, 2, GL_FLOAT, false, 0, textureCoordinates.data());
-
-			glDrawArrays(GL_TRIANGLES, 0, 6);
-			glDisableVertexAttribArray(program->positionAttribute);
-			glDisableVertexAttribArray(program->texCoordAttribute);
-		}
-	}
-	for (RideRequest* request : allRideRequests){
-		if ((request->getMatchedToVehicle() && time >= request->getRequestTime() - timeRadius) || (!request->getMatchedToVehicle() && (time - timeRadius) <= request->getRequestTime() && request->getRequestTime() <= (time + timeRadius))){
-			modelMatrix.identity();
-			modelMatrix.Translate(request->getLocation().second, request->getLocation().first, 0);
-			//modelMatrix.setPosition(1.0, -2.0, 0.0);
-			modelMatrix.Scale(scaleX, scaleY, 0);
-			//modelMatrix.Rotate(3.14/4);
-			objectVertices = { -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f };
-
-			textureCoordinates = requestTexture->getTextureCoordinates();
-			glBindTexture(GL_TEXTURE_2D, requestTexture->getTextureID());
-			program->setModelMatrix(modelMatrix);
-
-			glEnableVertexAttribArray(program->positionAttribute);
-			glVertexAttribPointer(program->positionAttribute, 2, GL_FLOAT, false, 0, objectVertices.data());
-
-			glEnableVertexAttribArray(program->texCoordAttribute);
-			glVertexAttribPointer(program->texCoordAttribute, 2, GL_FLOAT, false, 0, textureCoordinates.data());
-
-			glDrawArrays(GL_TRIANGLES, 0, 6);
-			glDisableVertexAttribArray(program->positionAttribute);
-			glDisableVertexAttribArray(program->texCoordAttribute);
-		}
-		//if (request->getMatchedToVehicle() && time >= request->getRequestTime() && time <= request->getRequestTime() + request->getDistanceOfRequest() + timeRadius){
-		//	modelMatrix.identity();
-		//	modelMatrix.Translate(request->getDestination().second, request->getDestination().first + 0.5, 0);
-		//	modelMatrix.Scale(scaleX, scaleY * 2, 0);
-		//	objectVertices = { -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f };
-		//	// {-x, -y}, {x, -y}, {x, y}
-		//	// {-x, -y}, {x, y}, {-x, y}
-
-		//	textureCoordinates = destinationTexture->getTextureCoordinates();
-		//	glBindTexture(GL_TEXTURE_2D, destinationTexture->getTextureID());
-		//	program->setModelMatrix(modelMatrix);
-
-		//	glEnableVertexAttribArray(program->positionAttribute);
-		//	glVertexAttribPointer(program->positionAttribute, 2, GL_FLOAT, false, 0, objectVertices.data());
-
-		//	glEnableVertexAttribArray(program->texCoordAttribute);
-		//	glVertexAttribPointer(program->texCoordAttribute, 2, GL_FLOAT, false, 0, textureCoordinates.data());
-
-		//	glDrawArrays(GL_TRIANGLES, 0, 6);
-		//	glDisableVertexAttribArray(program->positionAttribute);
-		//	glDisableVertexAttribArray(program->texCoordAttribute);
-		//	
-		//	float lineWidth = 0.5;
-
-		//	float destX = request->getDestination().second;
-		//	float destY = request->getDestination().first;
-
-		//	float locX = request->getLocation().second;
-		//	float locY = request->getLocation().first;
-
-		//	float dist = pythagDistance(locX, locY, destX, destY);
-
-		//	// Triangle Right: {-x, -y}, {x, -y}, {x, y}
-		//	// Triangle Left: {-x, -y}, {x, y}, {-x, y}
-		//	float centerX = (locX + destX) / 2;
-		//	float centerY = (locY + destY) / 2;
-
-		//	//float angle = atan2f(destY - locY, destX - locX);
-		//	float angle = abs(acosf((destY - locY) / dist));
-		//	while (angle >= M_PI){
-		//		angle -= M_PI;
-		//	}
-		//	//if (angle > 3.14159 / 4 && angle < 3.14159 / 3){
-		//	//	angle *= -1;
-		//	//}
-		//	if (destX > locX){
-		//		angle *= -1;
-		//	}
-		//	textureCoordinates = lineTexture->getTextureCoordinates();
-		//	glBindTexture(GL_TEXTURE_2D, lineTexture->getTextureID());
-		//	modelMatrix.identity();
-		//	modelMatrix.Translate(centerX, centerY, 0);
-		//	modelMatrix.Rotate(angle);
-		//	modelMatrix.Scale(lineWidth, dist, 0);
-		//	program->setModelMatrix(modelMatrix);
-
-		//	glEnableVertexAttribArray(program->positionAttribute);
-		//	glVertexAttribPointer(program->positionAttribute, 2, GL_FLOAT, false, 0, objectVertices.data());
-
-		//	glEnableVertexAttribArray(program->texCoordAttribute);
-		//	glVertexAttribPointer(program->texCoordAttribute, 2, GL_FLOAT, false, 0, textureCoordinates.data());
-
-		//	glDrawArrays(GL_TRIANGLES, 0, 6);
-		//	glDisableVertexAttribArray(program->positionAttribute);
-		//	glDisableVertexAttribArray(program->texCoordAttribute);
-		//}
-	}
-
-	//for (EventVenue* venue : allVenues){
-	//	modelMatrix.identity();
-	//	modelMatrix.Translate(venue->getLocation().second, venue->getLocation().first, 0);
-	//	//modelMatrix.setPosition(1.0, -2.0, 0.0);
-	//	modelMatrix.Scale(scaleX, scaleY, 0);
-	//	//modelMatrix.Rotate(3.14 / 4);
-	//	objectVertices = { -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f };
-
-	//	textureCoordinates = venueTexture->getTextureCoordinates();
-	//	glBindTexture(GL_TEXTURE_2D, venueTexture->getTextureID());
-	//	program->setModelMatrix(modelMatrix);
-
-	//	glEnableVertexAttribArray(program->positionAttribute);
-	//	glVertexAttribPointer(program->positionAttribute, 2, GL_FLOAT, false, 0, objectVertices.data());
-
-	//	glEnableVertexAttribArray(program->texCoordAttribute);
-	//	glVertexAttribPointer(program->texCoordAttribute, 2, GL_FLOAT, false, 0, textureCoordinates.data());
-
-	//	glDrawArrays(GL_TRIANGLES, 0, 6);
-	//	glDisableVertexAttribArray(program->positionAttribute);
-	//	glDisableVertexAttribArray(program->texCoordAttribute);
-	//}
-}
-
 int RequestManager::getSectionRadius(){
 	return sectionRadius;
 }
 
 void RequestManager::freeMemory(){
-	requestMap.clear();
+	std::vector<int>().swap(sectionStarts);
+	std::vector<RequestId>().swap(sectionRequests);
+	std::vector<int>().swap(sectionRequestTimes);
+	std::vector<RequestId>().swap(unmatchedRequests);
+	std::vector<int>().swap(unmatchedCounts);
 	//venueMap.clear();
 	lineTexture = nullptr;
 	//venueTexture = nullptr;
 	requestTexture = nullptr;
 	destinationTexture = nullptr;
-	for (int i = 0; i < allRideRequests.size(); i++){
-		delete allRideRequests[i];
-		allRideRequests[i] = nullptr;
-	}
-	allRideRequests.clear();
+	rideRequests.clear();
 	//for (int i = 0; i < allVenues.size(); i++){
 	//	delete allVenues[i];
 	//	allVenues[i] = nullptr;
@@ -1,24 +1,44 @@
 #ifndef _REQUEST_MANAGER_H
 #define _REQUEST_MANAGER_H
-#include <unordered_map>
+#include <vector>
 #include "Matrix.h"
+#include "RideRequestStore.h"
 
-class RideRequest;
 //class EventVenue;
 class Texture;
 class ShaderProgram;
+
 class RequestManager
 {
 protected:
-	std::unordered_map<int, std::unordered_map<int, std::vector<RideRequest*>>> requestMap;
+	//Row-major grid of sections: row is the latitude section, column is the longitude section. The requests of every section
+	//are indexed in a few arrays shared by the whole grid: section i owns the slice from sectionStarts[i] to sectionStarts[i + 1]
+	//of each. A request never changes sections, so the slices are sized once, when the index is built.
+	std::vector<int> sectionStarts;
+	//Requests of each section, in the order they were added.
+	std::vector<RequestId> sectionRequests;
+	//Request times of each section, kept sorted so time queries are binary searches.
+	std::vector<int> sectionRequestTimes;
+	//Requests of each section still open for matching, in no particular order, filling the first unmatchedCounts[i] places of
+	//its slice. The store keeps each request's position here.
+	std::vector<RequestId> unmatchedRequests;
+	std::vector<int> unmatchedCounts;
 	//std::unordered_map<int, std::unordered_map<int, std::vector<EventVenue*>>> venueMap;
-	std::vector<RideRequest*> allRideRequests;
+	RideRequestStore rideRequests;
 	//std::vector<EventVenue*> allVenues;
 	int latitudeMax, longitudeMax;
 	int latitudeMin, longitudeMin;
 	int sectionRadius;
+	int gridRows, gridColumns;
 
 	void normalizeCoordinates();
+	int snapToSection(int coordinate);
+	int getCellIndex(int latitude, int longitude);
+	int getCellIndex(std::pair<long, long> location);
+	int countRequestsInCell(int cellIndex, int timeBegin, int timeEnd);
+	void updateRequestTime(RequestId request, int previousTime);
+	void addUnmatchedRequest(RequestId request);
+	void removeUnmatchedRequest(RequestId request);
 	Matrix modelMatrix;
 	Texture* lineTexture;
 	Texture* gridTexture;
@@ -34,7 +54,9 @@ public:
 	void setLongitudeMax(int longitudeMax);
 	void setLatitudeMin(int latitudeMin);
 	void setLongitudeMin(int longitudeMin);
-	void addRequest(RideRequest* toAdd);
+	//Requests are searched for once indexRequests has been called after the last one is added.
+	RequestId addRequest(std::pair<long, long> location, std::pair<long, long> destination, int requestTime);
+	void indexRequests();
 	//void addVenue(EventVenue* toAdd);
 	void initializeRequestMap();
 
@@ -42,9 +64,21 @@ public:
 	std::pair<int, int> getMaxCoords();
 	int getSectionRadius();
 
-	std::vector<RideRequest*>& getRequestsAtLocation(std::pair<long, long> location);
+	void getRequestsAtLocation(std::pair<long, long> location, std::vector<RequestId>& requests);
+
+	//Row and column of the section a location falls in, clamped to the map the way searches are.
+	std::pair<int, int> getSection(std::pair<long, long> location);
+	int getGridRows(){ return gridRows; }
+	int getGridColumns(){ return gridColumns; }
+
+	int getRingForRadius(float radius);
+	void getRequestsInRing(std::pair<long, long> location, int innerRing, int outerRing, std::vector<RequestId>& candidates);
+
+	int getNumberOfRequestsAtLocation(std::pair<long, long> location, int time);
 
-	int getNumberOfRequestsAtLocation(std::pair<long, long> location, int time, int timeRadius);
+	//Change a request along with the sections indexing it.
+	void setRequestTime(RequestId request, int time);
+	void setMatchedToVehicle(RequestId request, bool matchedToVehicle);
 
 	void render(ShaderProgram* program, float time, float timeRadius, float scaleX, float scaleY);
 
@@ -55,7 +89,7 @@ public:
 	void setGridTexture(Texture* gridTexture){ this->gridTexture = gridTexture; }
 	void freeMemory();
 
-	std::vector<RideRequest*>& getAllRideRequests(){ return allRideRequests; }
+	RideRequestStore& getRideRequests(){ return rideRequests; }
 	//std::vector<EventVenue*>& getAllEventVenues(){ return allVenues; }
 };
 
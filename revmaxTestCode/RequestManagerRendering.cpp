@@ -0,0 +1,172 @@
+#include "RequestManager.h"
+//#include "EventVenue.h"
+#include "Texture.h"
+#include "ShaderProgram.h"
+#include "mathHelper.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327950288419
+#endif
+
+//Drawing is kept out of RequestManager.cpp so the simulation can be built without OpenGL.
+
+void RequestManager::render(ShaderProgram* program, float time, float timeRadius, float scaleX, float scaleY){
+	std::vector<GLfloat> objectVertices;
+	std::vector<GLfloat> textureCoordinates;
+	for (int i = longitudeMin; i <= longitudeMax; i += sectionRadius){
+		for (int j = latitudeMin; j <= latitudeMax; j += sectionRadius){
+			modelMatrix.identity();
+			modelMatrix.Translate(i, j, 0);
+			modelMatrix.Scale(sectionRadius, 0.25, 0);
+			objectVertices = { -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f };
+
+			textureCoordinates = gridTexture->getTextureCoordinates();
+			glBindTexture(GL_TEXTURE_2D, gridTexture->getTextureID());
+			program->setModelMatrix(modelMatrix);
+
+			glEnableVertexAttribArray(program->positionAttribute);
+			glVertexAttribPointer(program->positionAttribute, 2, GL_FLOAT, false, 0, objectVertices.data());
+
+			glEnableVertexAttribArray(program->texCoordAttribute);
+			glVertexAttribPointer(program->texCoordAttribute, 2, GL_FLOAT, false, 0, textureCoordinates.data());
+
+			glDrawArrays(GL_TRIANGLES, 0, 6);
+			glDisableVertexAttribArray(program->positionAttribute);
+			glDisableVertexAttribArray(program->texCoordAttribute);
+
+			modelMatrix.setScale(1, 1, 0);
+			//modelMatrix.Translate(sectionRadius, 0, 0);
+			modelMatrix.setScale(0.5, sectionRadius, 0);
+			objectVertices = { -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f };
+
+			textureCoordinates = gridTexture->getTextureCoordinates();
+			glBindTexture(GL_TEXTURE_2D, gridTexture->getTextureID());
+			program->setModelMatrix(modelMatrix);
+
+			glEnableVertexAttribArray(program->positionAttribute);
+			glVertexAttribPointer(program->positionAttribute, 2, GL_FLOAT, false, 0, objectVertices.data());
+
+			glEnableVertexAttribArray(program->texCoordAttribute);
+			glVertexAttribPointer(program->texCoordAttribute, 2, GL_FLOAT, false, 0, textureCoordinates.data());
+
+			glDrawArrays(GL_TRIANGLES, 0, 6);
+			glDisableVertexAttribArray(program->positionAttribute);
+			glDisableVertexAttribArray(program->texCoordAttribute);
+		}
+	}
+	for (RequestId request = 0; request < (RequestId)rideRequests.size(); request++){
+		bool matchedToVehicle = rideRequests.getMatchedToVehicle(request);
+		int requestTime = rideRequests.getRequestTime(request);
+		if ((matchedToVehicle && time >= requestTime - timeRadius) || (!matchedToVehicle && (time - timeRadius) <= requestTime && requestTime <= (time + timeRadius))){
+			modelMatrix.identity();
+			modelMatrix.Translate(rideRequests.getLocation(request).second, rideRequests.getLocation(request).first, 0);
+			//modelMatrix.setPosition(1.0, -2.0, 0.0);
+			modelMatrix.Scale(scaleX, scaleY, 0);
+			//modelMatrix.Rotate(3.14/4);
+			objectVertices = { -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f };
+
+			textureCoordinates = requestTexture->getTextureCoordinates();
+			glBindTexture(GL_TEXTURE_2D, requestTexture->getTextureID());
+			program->setModelMatrix(modelMatrix);
+
+			glEnableVertexAttribArray(program->positionAttribute);
+			glVertexAttribPointer(program->positionAttribute, 2, GL_FLOAT, false, 0, objectVertices.data());
+
+			glEnableVertexAttribArray(program->texCoordAttribute);
+			glVertexAttribPointer(program->texCoordAttribute, 2, GL_FLOAT, false, 0, textureCoordinates.data());
+
+			glDrawArrays(GL_TRIANGLES, 0, 6);
+			glDisableVertexAttribArray(program->positionAttribute);
+			glDisableVertexAttribArray(program->texCoordAttribute);
+		}
+		//if (request->getMatchedToVehicle() && time >= request->getRequestTime() && time <= request->getRequestTime() + request->getDistanceOfRequest() + timeRadius){
+		//	modelMatrix.identity();
+		//	modelMatrix.Translate(request->getDestination().second, request->getDestination().first + 0.5, 0);
+		//	modelMatrix.Scale(scaleX, scaleY * 2, 0);
+		//	objectVertices = { -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f };
+		//	// {-x, -y}, {x, -y}, {x, y}
+		//	// {-x, -y}, {x, y}, {-x, y}
+
+		//	textureCoordinates = destinationTexture->getTextureCoordinates();
+		//	glBindTexture(GL_TEXTURE_2D, destinationTexture->getTextureID());
+		//	program->setModelMatrix(modelMatrix);
+
+		//	glEnableVertexAttribArray(program->positionAttribute);
+		//	glVertexAttribPointer(program->positionAttribute, 2, GL_FLOAT, false, 0, objectVertices.data());
+
+		//	glEnableVertexAttribArray(program->texCoordAttribute);
+		//	glVertexAttribPointer(program->texCoordAttribute, 2, GL_FLOAT, false, 0, textureCoordinates.data());
+
+		//	glDrawArrays(GL_TRIANGLES, 0, 6);
+		//	glDisableVertexAttribArray(program->positionAttribute);
+		//	glDisableVertexAttribArray(program->texCoordAttribute);
+		//	
+		//	float lineWidth = 0.5;
+
+		//	float destX = request->getDestination().second;
+		//	float destY = request->getDestination().first;
+
+		//	float locX = request->getLocation().second;
+		//	float locY = request->getLocation().first;
+
+		//	float dist = pythagDistance(locX, locY, destX, destY);
+
+		//	// Triangle Right: {-x, -y}, {x, -y}, {x, y}
+		//	// Triangle Left: {-x, -y}, {x, y}, {-x, y}
+		//	float centerX = (locX + destX) / 2;
+		//	float centerY = (locY + destY) / 2;
+
+		//	//float angle = atan2f(destY - locY, destX - locX);
+		//	float angle = abs(acosf((destY - locY) / dist));
+		//	while (angle >= M_PI){
+		//		angle -= M_PI;
+		//	}
+		//	//if (angle > 3.14159 / 4 && angle < 3.14159 / 3){
+		//	//	angle *= -1;
+		//	//}
+		//	if (destX > locX){
+		//		angle *= -1;
+		//	}
+		//	textureCoordinates = lineTexture->getTextureCoordinates();
+		//	glBindTexture(GL_TEXTURE_2D, lineTexture->getTextureID());
+		//	modelMatrix.identity();
+		//	modelMatrix.Translate(centerX, centerY, 0);
+		//	modelMatrix.Rotate(angle);
+		//	modelMatrix.Scale(lineWidth, dist, 0);
+		//	program->setModelMatrix(modelMatrix);
+
+		//	glEnableVertexAttribArray(program->positionAttribute);
+		//	glVertexAttribPointer(program->positionAttribute, 2, GL_FLOAT, false, 0, objectVertices.data());
+
+		//	glEnableVertexAttribArray(program->texCoordAttribute);
+		//	glVertexAttribPointer(program->texCoordAttribute, 2, GL_FLOAT, false, 0, textureCoordinates.data());
+
+		//	glDrawArrays(GL_TRIANGLES, 0, 6);
+		//	glDisableVertexAttribArray(program->positionAttribute);
+		//	glDisableVertexAttribArray(program->texCoordAttribute);
+		//}
+	}
+
+	//for (EventVenue* venue : allVenues){
+	//	modelMatrix.identity();
+	//	modelMatrix.Translate(venue->getLocation().second, venue->getLocation().first, 0);
+	//	//modelMatrix.setPosition(1.0, -2.0, 0.0);
+	//	modelMatrix.Scale(scaleX, scaleY, 0);
+	//	//modelMatrix.Rotate(3.14 / 4);
+	//	objectVertices = { -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f };
+
+	//	textureCoordinates = venueTexture->getTextureCoordinates();
+	//	glBindTexture(GL_TEXTURE_2D, venueTexture->getTextureID());
+	//	program->setModelMatrix(modelMatrix);
+
+	//	glEnableVertexAttribArray(program->positionAttribute);
+	//	glVertexAttribPointer(program->positionAttribute, 2, GL_FLOAT, false, 0, objectVertices.data());
+
+	//	glEnableVertexAttribArray(program->texCoordAttribute);
+	//	glVertexAttribPointer(program->texCoordAttribute, 2, GL_FLOAT, false, 0, textureCoordinates.data());
+
+	//	glDrawArrays(GL_TRIANGLES, 0, 6);
+	//	glDisableVertexAttribArray(program->positionAttribute);
+	//	glDisableVertexAttribArray(program->texCoordAttribute);
+	//}
+}
@@ -0,0 +1,64 @@
+#include "ResultsTable.h"
+
+//Rows are held until about this much is waiting, then written at once.
+static const size_t RESULTS_BUFFER_SIZE = 1 << 20;
+
+void ResultsTable::writeBuffer(){
+	file.write(buffer.data(), buffer.size());
+	if (file.fail()){
+		failed = true;
+	}
+	buffer.clear();
+}
+
+void ResultsTable::open(const std::string& filePath, const std::vector<const char*>& columnNames){
+	file.open(filePath.c_str(), std::ios::binary);
+	if (!file.is_open()){
+		throw "Could not write the results file!";
+	}
+	failed = false;
+	buffer.reserve(RESULTS_BUFFER_SIZE + RESULTS_BUFFER_SIZE / 4);
+	for (size_t i = 0; i < columnNames.size(); i++){
+		if (i > 0){
+			buffer += ',';
+		}
+		buffer += columnNames[i];
+	}
+	buffer += '\n';
+}
+
+void ResultsTable::addRows(const std::string& rows){
+	std::lock_guard<std::mutex> guard(lock);
+	buffer += rows;
+	if (buffer.size() >= RESULTS_BUFFER_SIZE){
+		writeBuffer();
+	}
+}
+
+void ResultsTable::close(){
+	std::lock_guard<std::mutex> guard(lock);
+	if (!file.is_open()){
+		return;
+	}
+	writeBuffer();
+	file.close();
+	std::string().swap(buffer);
+	if (failed || file.fail()){
+		throw "Could not write the results file!";
+	}
+}
+
+void ResultsTable::appendField(std::string& row, const std::string& field){
+	if (field.find_first_of(",\"\r\n") == std::string::npos){
+		row += field;
+		return;
+	}
+	row += '"';
+	for (char c : field){
+		if (c == '"'){
+			row += '"';
+		}
+		row += c;
+	}
+	row += '"';
+}
@@ -0,0 +1,37 @@
+#ifndef _RESULTS_TABLE_H
+#define _RESULTS_TABLE_H
+#include <string>
+#include <vector>
+#include <fstream>
+#include <mutex>
+
+//A comma separated results file that every test of a run adds rows to. A test formats its rows itself, then appends them
+//to a shared buffer under a lock in one go. The buffer reaches the file in large writes, so a test never waits on the
+//disk and rows from tests running side by side never interleave.
+class ResultsTable
+{
+protected:
+	std::mutex lock;
+	std::ofstream file;
+	std::string buffer;
+	bool failed;
+
+	void writeBuffer();
+public:
+	ResultsTable() : failed(false){}
+	ResultsTable(const ResultsTable&) = delete;
+	ResultsTable& operator=(const ResultsTable&) = delete;
+
+	//Starts the file with a header row of the column names.
+	void open(const std::string& filePath, const std::vector<const char*>& columnNames);
+	bool isOpen(){ return file.is_open(); }
+	//Appends whole rows, each ending in '\n'.
+	void addRows(const std::string& rows);
+	//Writes what is left of the buffer and closes the file. Throws if any write failed.
+	void close();
+
+	//Appends a text field, quoted when it holds a separator, quote or line break.
+	static void appendField(std::string& row, const std::string& field);
+};
+
+#endif
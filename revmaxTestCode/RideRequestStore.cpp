@@ -0,0 +1,63 @@
+#include "RideRequestStore.h"
+
+RequestId RideRequestStore::addRequest(std::pair<long, long> location, std::pair<long, long> destination, int requestTime){
+	RequestId request = (RequestId)size();
+	locationLatitudes.push_back((int)location.first);
+	locationLongitudes.push_back((int)location.second);
+	destinationLatitudes.push_back((int)destination.first);
+	destinationLongitudes.push_back((int)destination.second);
+	requestTimes.push_back(requestTime);
+	timesMatched.push_back(0);
+	distancesToRequest.push_back(0);
+	distancesOfRequest.push_back(0);
+	requestsAtDestination.push_back(0);
+	statuses.push_back(0);
+	cellIndices.push_back(-1);
+	unmatchedIndices.push_back(-1);
+	return request;
+}
+
+void RideRequestStore::reserve(size_t requestCount){
+	locationLatitudes.reserve(requestCount);
+	locationLongitudes.reserve(requestCount);
+	destinationLatitudes.reserve(requestCount);
+	destinationLongitudes.reserve(requestCount);
+	requestTimes.reserve(requestCount);
+	timesMatched.reserve(requestCount);
+	distancesToRequest.reserve(requestCount);
+	distancesOfRequest.reserve(requestCount);
+	requestsAtDestination.reserve(requestCount);
+	statuses.reserve(requestCount);
+	cellIndices.reserve(requestCount);
+	unmatchedIndices.reserve(requestCount);
+}
+
+void RideRequestStore::clear(){
+	//Swapping with empty arrays gives the memory back, which clearing alone would not.
+	std::vector<int>().swap(locationLatitudes);
+	std::vector<int>().swap(locationLongitudes);
+	std::vector<int>().swap(destinationLatitudes);
+	std::vector<int>().swap(destinationLongitudes);
+	std::vector<int>().swap(requestTimes);
+	std::vector<int>().swap(timesMatched);
+	std::vector<int>().swap(distancesToRequest);
+	std::vector<int>().swap(distancesOfRequest);
+	std::vector<unsigned>().swap(requestsAtDestination);
+	std::vector<unsigned char>().swap(statuses);
+	std::vector<int>().swap(cellIndices);
+	std::vector<int>().swap(unmatchedIndices);
+}
+
+void RideRequestStore::setStatus(RequestId request, unsigned char flag, bool value){
+	if (value){
+		statuses[request] |= flag;
+	}
+	else{
+		statuses[request] &= ~flag;
+	}
+}
+
+void RideRequestStore::setDistanceOfRequest(RequestId request, long distanceOfRequest){
+	distancesOfRequest[request] = (int)distanceOfRequest;
+	setStatus(request, DISTANCE_OF_REQUEST_CALCULATED, true);
+}
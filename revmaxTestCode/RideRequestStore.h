@@ -0,0 +1,70 @@
+#ifndef _RIDE_REQUEST_STORE_H
+#define _RIDE_REQUEST_STORE_H
+#include <vector>
+#include <utility>
+#include <stddef.h>
+
+//Requests are named by their position in the store they were added to.
+typedef int RequestId;
+const RequestId NO_REQUEST = -1;
+
+class RequestManager;
+//Every ride request of a test, field by field: one array per field, indexed by request id. A search only reads the
+//fields it scores with, so it walks a few tightly packed arrays instead of one scattered object per request.
+//Coordinates, times and distances are whole numbers that fit in 32 bits, whatever the size of a long.
+class RideRequestStore
+{
+protected:
+	enum STATUS_FLAG { PICKED_UP = 1, MATCHED_TO_VEHICLE = 2, DISTANCE_OF_REQUEST_CALCULATED = 4 };
+
+	std::vector<int> locationLatitudes, locationLongitudes;
+	std::vector<int> destinationLatitudes, destinationLongitudes;
+	//Request time is an integer representing the hour - right now using an hour timestep for testing purposes
+	std::vector<int> requestTimes;
+	std::vector<int> timesMatched;
+	//Set upon routing for later use
+	std::vector<int> distancesToRequest, distancesOfRequest;
+	std::vector<unsigned> requestsAtDestination;
+	std::vector<unsigned char> statuses;
+	//Section of the manager's grid holding each request, and its position in that section's unmatched list.
+	std::vector<int> cellIndices;
+	std::vector<int> unmatchedIndices;
+
+	bool getStatus(RequestId request, unsigned char flag){ return (statuses[request] & flag) != 0; }
+	void setStatus(RequestId request, unsigned char flag, bool value);
+
+	//Only the request manager changes these, as it indexes requests by both.
+	friend class RequestManager;
+	void setRequestTime(RequestId request, int time){ requestTimes[request] = time; }
+	void setMatchedToVehicle(RequestId request, bool matchedToVehicle){ setStatus(request, MATCHED_TO_VEHICLE, matchedToVehicle); }
+	void setCellIndex(RequestId request, int cellIndex){ cellIndices[request] = cellIndex; }
+	void setUnmatchedIndex(RequestId request, int unmatchedIndex){ unmatchedIndices[request] = unmatchedIndex; }
+public:
+	RequestId addRequest(std::pair<long, long> location, std::pair<long, long> destination, int requestTime);
+	void reserve(size_t requestCount);
+	void clear();
+	size_t size(){ return requestTimes.size(); }
+
+	std::pair<long, long> getLocation(RequestId request){ return std::make_pair((long)locationLatitudes[request], (long)locationLongitudes[request]); }
+	std::pair<long, long> getDestination(RequestId request){ return std::make_pair((long)destinationLatitudes[request], (long)destinationLongitudes[request]); }
+	int getRequestTime(RequestId request){ return requestTimes[request]; }
+	int getTimeMatched(RequestId request){ return timesMatched[request]; }
+	long getDistanceToRequest(RequestId request){ return distancesToRequest[request]; }
+	long getDistanceOfRequest(RequestId request){ return distancesOfRequest[request]; }
+	unsigned getRequestsAtDestination(RequestId request){ return requestsAtDestination[request]; }
+	bool getPickedUp(RequestId request){ return getStatus(request, PICKED_UP); }
+	bool getMatchedToVehicle(RequestId request){ return getStatus(request, MATCHED_TO_VEHICLE); }
+	//Only a calculation flag for distance: will not change, but requests at destination might (if new requests crop up, or if a ride would arrive
+	//at a time when requests are forecasted.
+	bool getDistanceOfRequestCalculated(RequestId request){ return getStatus(request, DISTANCE_OF_REQUEST_CALCULATED); }
+	int getCellIndex(RequestId request){ return cellIndices[request]; }
+	int getUnmatchedIndex(RequestId request){ return unmatchedIndices[request]; }
+
+	void setTimeMatched(RequestId request, int time){ timesMatched[request] = time; }
+	void setPickedUp(RequestId request, bool pickedUp){ setStatus(request, PICKED_UP, pickedUp); }
+	void setDistanceToRequest(RequestId request, long distanceToRequest){ distancesToRequest[request] = (int)distanceToRequest; }
+	void setDistanceOfRequest(RequestId request, long distanceOfRequest);
+	void setRequestsAtDestination(RequestId request, unsigned requestsAtDestination){ this->requestsAtDestination[request] = requestsAtDestination; }
+};
+
+#endif
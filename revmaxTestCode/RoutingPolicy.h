@@ -0,0 +1,39 @@
+#ifndef _ROUTING_POLICY_H
+#define _ROUTING_POLICY_H
+#include <math.h>
+
+//Routing policies measure the distance a vehicle travels between two points. The scoring loop is templated on the policy,
+//so the chosen metric is inlined rather than called through a pointer.
+
+//Straight line distance.
+struct EuclideanRouting{
+	static inline float distance(float x1, float y1, float x2, float y2){
+		float dx = x2 - x1;
+		float dy = y2 - y1;
+		return sqrtf(dx * dx + dy * dy);
+	}
+	static inline const char* description(){ return "Pythagorean Theorem"; }
+};
+
+//Distance along streets laid out as a grid, with no diagonal travel.
+struct ManhattanRouting{
+	static inline float distance(float x1, float y1, float x2, float y2){
+		return fabsf(x2 - x1) + fabsf(y2 - y1);
+	}
+	static inline const char* description(){ return "Manhattan Distance"; }
+};
+
+//Shortest path over a street grid with a node at every whole coordinate, linked to its eight neighbours.
+//With no closed streets the shortest path has a closed form: diagonal steps cover the shorter axis, straight steps the rest.
+struct GridGraphRouting{
+	static inline float distance(float x1, float y1, float x2, float y2){
+		float dx = fabsf(x2 - x1);
+		float dy = fabsf(y2 - y1);
+		float shorter = dx < dy ? dx : dy;
+		float longer = dx < dy ? dy : dx;
+		return longer + (1.41421356f - 1) * shorter;
+	}
+	static inline const char* description(){ return "Grid Graph Shortest Path"; }
+};
+
+#endif
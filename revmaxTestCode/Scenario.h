@@ -0,0 +1,31 @@
+#ifndef _SCENARIO_H
+#define _SCENARIO_H
+#include <vector>
+#include <memory>
+#include <stddef.h>
+#include "MappedFile.h"
+#include "ScenarioFile.h"
+
+//The map, requests and vehicles of a ranged sweep as they stand before any test has run. Every test of the sweep shares
+//one, read only, and builds its own request manager, requests and vehicles from it when it starts.
+struct Scenario{
+	float maxLat, maxLong;
+	float sectionSize;
+
+	//Point into the records below when the scenario was drawn or read from a test file, or straight into the
+	//mapped binary scenario file otherwise.
+	const ScenarioRequest* requests;
+	size_t requestCount;
+	const ScenarioVehicle* vehicles;
+	size_t vehicleCount;
+
+	std::vector<ScenarioRequest> requestRecords;
+	std::vector<ScenarioVehicle> vehicleRecords;
+	std::shared_ptr<MappedFile> file;
+
+	Scenario() : maxLat(0), maxLong(0), sectionSize(0), requests(nullptr), requestCount(0), vehicles(nullptr), vehicleCount(0){}
+	Scenario(const Scenario&) = delete;
+	Scenario& operator=(const Scenario&) = delete;
+};
+
+#endif
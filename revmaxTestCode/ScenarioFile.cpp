@@ -0,0 +1,63 @@
+#include "ScenarioFile.h"
+#include <fstream>
+#include <string.h>
+
+static const char SCENARIO_FILE_MAGIC[4] = { 'R', 'V', 'S', 'C' };
+
+ScenarioFileHeader makeScenarioFileHeader(){
+	ScenarioFileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, SCENARIO_FILE_MAGIC, sizeof(header.magic));
+	header.version = SCENARIO_FILE_VERSION;
+	header.byteOrder = SCENARIO_FILE_BYTE_ORDER;
+	header.headerSize = sizeof(ScenarioFileHeader);
+	return header;
+}
+
+bool isScenarioFile(MappedFile& file){
+	return file.getSize() >= sizeof(SCENARIO_FILE_MAGIC) && memcmp(file.begin(), SCENARIO_FILE_MAGIC, sizeof(SCENARIO_FILE_MAGIC)) == 0;
+}
+
+const ScenarioFileHeader& readScenarioFileHeader(MappedFile& file){
+	if (!isScenarioFile(file) || file.getSize() < sizeof(ScenarioFileHeader)){
+		throw "Not a scenario file!";
+	}
+	//The mapping starts on a page boundary, so the header and the arrays after it are aligned.
+	const ScenarioFileHeader& header = *reinterpret_cast<const ScenarioFileHeader*>(file.begin());
+	if (header.byteOrder != SCENARIO_FILE_BYTE_ORDER){
+		throw "Scenario file written with the other byte order!";
+	}
+	if (header.version != SCENARIO_FILE_VERSION || header.headerSize != sizeof(ScenarioFileHeader)){
+		throw "Unsupported scenario file version!";
+	}
+	uint64_t arraysSize = file.getSize() - sizeof(ScenarioFileHeader);
+	//The counts are bounded first, so the sizes computed from them cannot overflow.
+	if (header.requestCount > arraysSize / sizeof(ScenarioRequest) || header.vehicleCount > arraysSize / sizeof(ScenarioVehicle) ||
+		arraysSize != header.requestCount * sizeof(ScenarioRequest) + header.vehicleCount * sizeof(ScenarioVehicle)){
+		throw "Truncated scenario file!";
+	}
+	return header;
+}
+
+const ScenarioRequest* getScenarioRequests(MappedFile& file){
+	return reinterpret_cast<const ScenarioRequest*>(file.begin() + sizeof(ScenarioFileHeader));
+}
+
+const ScenarioVehicle* getScenarioVehicles(MappedFile& file){
+	const ScenarioFileHeader& header = *reinterpret_cast<const ScenarioFileHeader*>(file.begin());
+	return reinterpret_cast<const ScenarioVehicle*>(file.begin() + sizeof(ScenarioFileHeader) + header.requestCount * sizeof(ScenarioRequest));
+}
+
+void writeScenarioFile(const std::string& filePath, const ScenarioFileHeader& header, const ScenarioRequest* requests, const ScenarioVehicle* vehicles){
+	std::ofstream scenario(filePath.c_str(), std::ios::binary);
+	if (!scenario.is_open()){
+		throw "Could not write the scenario file!";
+	}
+	scenario.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	scenario.write(reinterpret_cast<const char*>(requests), header.requestCount * sizeof(ScenarioRequest));
+	scenario.write(reinterpret_cast<const char*>(vehicles), header.vehicleCount * sizeof(ScenarioVehicle));
+	scenario.close();
+	if (scenario.fail()){
+		throw "Could not write the scenario file!";
+	}
+}
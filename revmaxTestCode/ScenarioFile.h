@@ -0,0 +1,62 @@
+#ifndef _SCENARIO_FILE_H
+#define _SCENARIO_FILE_H
+#include <string>
+#include <stdint.h>
+#include "MappedFile.h"
+
+//A binary scenario file is a ScenarioFileHeader, then requestCount ScenarioRequests, then vehicleCount ScenarioVehicles,
+//all in the byte order of the machine that wrote it. Every field is fixed width, so the arrays are used where they are
+//mapped, with nothing to parse.
+const uint32_t SCENARIO_FILE_VERSION = 1;
+//Reads back in the wrong order on a machine of the other byte order, which is then refused instead of misread.
+const uint32_t SCENARIO_FILE_BYTE_ORDER = 0x01020304;
+
+struct ScenarioRequest{
+	int32_t locationLat, locationLong;
+	int32_t destinationLat, destinationLong;
+	int32_t requestTime;
+};
+
+struct ScenarioVehicle{
+	int32_t latitude, longitude;
+};
+
+struct ScenarioFileHeader{
+	char magic[4];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint32_t headerSize;
+
+	//The request manager's map.
+	int32_t minLat, minLong, maxLat, maxLong;
+	int32_t sectionSize;
+
+	//The test's parameters, as a test file's Parameters element gives them.
+	float weightOfDistanceOfTrip;
+	uint32_t timesToRun;
+	float radiusMin, radiusStep, radiusMax;
+	float timeRadius;
+	float minimumScore;
+	int32_t maxRideRequests;
+	int32_t routingMetric, simulationMode, dispatchMode;
+	uint32_t scoringThreads;
+	uint32_t reserved;
+
+	uint64_t requestCount;
+	uint64_t vehicleCount;
+};
+
+static_assert(sizeof(ScenarioRequest) == 20 && sizeof(ScenarioVehicle) == 8 && sizeof(ScenarioFileHeader) == 104, "Scenario file records must have no padding!");
+
+//Fills in the magic, version, byte order and header size of a header about to be written. Everything else starts at 0.
+ScenarioFileHeader makeScenarioFileHeader();
+//Whether the text starts like a binary scenario file, which test files never do.
+bool isScenarioFile(MappedFile& file);
+//Checks a mapped file is a whole scenario file this build reads and returns its header. Throws if it is not.
+const ScenarioFileHeader& readScenarioFileHeader(MappedFile& file);
+//The arrays of a mapped file readScenarioFileHeader accepted.
+const ScenarioRequest* getScenarioRequests(MappedFile& file);
+const ScenarioVehicle* getScenarioVehicles(MappedFile& file);
+void writeScenarioFile(const std::string& filePath, const ScenarioFileHeader& header, const ScenarioRequest* requests, const ScenarioVehicle* vehicles);
+
+#endif
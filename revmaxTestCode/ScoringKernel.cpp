@@ -0,0 +1,222 @@
+#include "ScoringKernel.h"
+#include <math.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SCORING_KERNEL_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SCORING_KERNEL_SSE
+#endif
+
+void CandidateBatch::clear(){
+	pickupLatitude.clear();
+	pickupLongitude.clear();
+	destinationLatitude.clear();
+	destinationLongitude.clear();
+	cachedRideDistance.clear();
+	requestTime.clear();
+	requestsAtDestination.clear();
+	pickupDistance.clear();
+	rideDistance.clear();
+	feasible.clear();
+	score.clear();
+}
+
+void CandidateBatch::addCandidate(RideRequestStore& rideRequests, RequestId request){
+	pickupLatitude.push_back(rideRequests.getLocation(request).first);
+	pickupLongitude.push_back(rideRequests.getLocation(request).second);
+	destinationLatitude.push_back(rideRequests.getDestination(request).first);
+	destinationLongitude.push_back(rideRequests.getDestination(request).second);
+	cachedRideDistance.push_back(rideRequests.getDistanceOfRequestCalculated(request) ? rideRequests.getDistanceOfRequest(request) : -1);
+	requestTime.push_back(rideRequests.getRequestTime(request));
+	requestsAtDestination.push_back(0);
+}
+
+template<>
+void computeCandidateDistances<EuclideanRouting>(CandidateBatch& batch, float vehicleLatitude, float vehicleLongitude){
+	size_t count = batch.size();
+	batch.pickupDistance.resize(count);
+	batch.rideDistance.resize(count);
+	size_t i = 0;
+#if defined(SCORING_KERNEL_AVX)
+	__m256 vehicleLat = _mm256_set1_ps(vehicleLatitude);
+	__m256 vehicleLong = _mm256_set1_ps(vehicleLongitude);
+	__m256 zero = _mm256_setzero_ps();
+	for (; i + 8 <= count; i += 8){
+		__m256 pickupLat = _mm256_loadu_ps(&batch.pickupLatitude[i]);
+		__m256 pickupLong = _mm256_loadu_ps(&batch.pickupLongitude[i]);
+		__m256 dLat = _mm256_sub_ps(pickupLat, vehicleLat);
+		__m256 dLong = _mm256_sub_ps(pickupLong, vehicleLong);
+		_mm256_storeu_ps(&batch.pickupDistance[i], _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dLat, dLat), _mm256_mul_ps(dLong, dLong))));
+
+		dLat = _mm256_sub_ps(_mm256_loadu_ps(&batch.destinationLatitude[i]), pickupLat);
+		dLong = _mm256_sub_ps(_mm256_loadu_ps(&batch.destinationLongitude[i]), pickupLong);
+		__m256 ride = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dLat, dLat), _mm256_mul_ps(dLong, dLong)));
+		__m256 cached = _mm256_loadu_ps(&batch.cachedRideDistance[i]);
+		_mm256_storeu_ps(&batch.rideDistance[i], _mm256_blendv_ps(cached, ride, _mm256_cmp_ps(cached, zero, _CMP_LT_OQ)));
+	}
+#elif defined(SCORING_KERNEL_SSE)
+	__m128 vehicleLat = _mm_set1_ps(vehicleLatitude);
+	__m128 vehicleLong = _mm_set1_ps(vehicleLongitude);
+	__m128 zero = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4){
+		__m128 pickupLat = _mm_loadu_ps(&batch.pickupLatitude[i]);
+		__m128 pickupLong = _mm_loadu_ps(&batch.pickupLongitude[i]);
+		__m128 dLat = _mm_sub_ps(pickupLat, vehicleLat);
+		__m128 dLong = _mm_sub_ps(pickupLong, vehicleLong);
+		_mm_storeu_ps(&batch.pickupDistance[i], _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dLat, dLat), _mm_mul_ps(dLong, dLong))));
+
+		dLat = _mm_sub_ps(_mm_loadu_ps(&batch.destinationLatitude[i]), pickupLat);
+		dLong = _mm_sub_ps(_mm_loadu_ps(&batch.destinationLongitude[i]), pickupLong);
+		__m128 ride = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dLat, dLat), _mm_mul_ps(dLong, dLong)));
+		__m128 cached = _mm_loadu_ps(&batch.cachedRideDistance[i]);
+		__m128 uncached = _mm_cmplt_ps(cached, zero);
+		_mm_storeu_ps(&batch.rideDistance[i], _mm_or_ps(_mm_and_ps(uncached, ride), _mm_andnot_ps(uncached, cached)));
+	}
+#endif
+	computeRemainingDistances<EuclideanRouting>(batch, i, vehicleLatitude, vehicleLongitude);
+}
+
+template<>
+void computeCandidateDistances<ManhattanRouting>(CandidateBatch& batch, float vehicleLatitude, float vehicleLongitude){
+	size_t count = batch.size();
+	batch.pickupDistance.resize(count);
+	batch.rideDistance.resize(count);
+	size_t i = 0;
+#if defined(SCORING_KERNEL_AVX)
+	__m256 vehicleLat = _mm256_set1_ps(vehicleLatitude);
+	__m256 vehicleLong = _mm256_set1_ps(vehicleLongitude);
+	__m256 zero = _mm256_setzero_ps();
+	//Clearing the sign bit gives the absolute value.
+	__m256 signBit = _mm256_set1_ps(-0.0f);
+	for (; i + 8 <= count; i += 8){
+		__m256 pickupLat = _mm256_loadu_ps(&batch.pickupLatitude[i]);
+		__m256 pickupLong = _mm256_loadu_ps(&batch.pickupLongitude[i]);
+		__m256 dLat = _mm256_andnot_ps(signBit, _mm256_sub_ps(pickupLat, vehicleLat));
+		__m256 dLong = _mm256_andnot_ps(signBit, _mm256_sub_ps(pickupLong, vehicleLong));
+		_mm256_storeu_ps(&batch.pickupDistance[i], _mm256_add_ps(dLat, dLong));
+
+		dLat = _mm256_andnot_ps(signBit, _mm256_sub_ps(_mm256_loadu_ps(&batch.destinationLatitude[i]), pickupLat));
+		dLong = _mm256_andnot_ps(signBit, _mm256_sub_ps(_mm256_loadu_ps(&batch.destinationLongitude[i]), pickupLong));
+		__m256 ride = _mm256_add_ps(dLat, dLong);
+		__m256 cached = _mm256_loadu_ps(&batch.cachedRideDistance[i]);
+		_mm256_storeu_ps(&batch.rideDistance[i], _mm256_blendv_ps(cached, ride, _mm256_cmp_ps(cached, zero, _CMP_LT_OQ)));
+	}
+#elif defined(SCORING_KERNEL_SSE)
+	__m128 vehicleLat = _mm_set1_ps(vehicleLatitude);
+	__m128 vehicleLong = _mm_set1_ps(vehicleLongitude);
+	__m128 zero = _mm_setzero_ps();
+	__m128 signBit = _mm_set1_ps(-0.0f);
+	for (; i + 4 <= count; i += 4){
+		__m128 pickupLat = _mm_loadu_ps(&batch.pickupLatitude[i]);
+		__m128 pickupLong = _mm_loadu_ps(&batch.pickupLongitude[i]);
+		__m128 dLat = _mm_andnot_ps(signBit, _mm_sub_ps(pickupLat, vehicleLat));
+		__m128 dLong = _mm_andnot_ps(signBit, _mm_sub_ps(pickupLong, vehicleLong));
+		_mm_storeu_ps(&batch.pickupDistance[i], _mm_add_ps(dLat, dLong));
+
+		dLat = _mm_andnot_ps(signBit, _mm_sub_ps(_mm_loadu_ps(&batch.destinationLatitude[i]), pickupLat));
+		dLong = _mm_andnot_ps(signBit, _mm_sub_ps(_mm_loadu_ps(&batch.destinationLongitude[i]), pickupLong));
+		__m128 ride = _mm_add_ps(dLat, dLong);
+		__m128 cached = _mm_loadu_ps(&batch.cachedRideDistance[i]);
+		__m128 uncached = _mm_cmplt_ps(cached, zero);
+		_mm_storeu_ps(&batch.rideDistance[i], _mm_or_ps(_mm_and_ps(uncached, ride), _mm_andnot_ps(uncached, cached)));
+	}
+#endif
+	computeRemainingDistances<ManhattanRouting>(batch, i, vehicleLatitude, vehicleLongitude);
+}
+
+void markFeasibleCandidates(CandidateBatch& batch, int timeToUse, int timeRadius){
+	size_t count = batch.size();
+	batch.feasible.resize(count);
+	size_t i = 0;
+#if defined(SCORING_KERNEL_AVX)
+	__m256 start = _mm256_set1_ps((float)timeToUse);
+	__m256 radius = _mm256_set1_ps((float)timeRadius);
+	for (; i + 8 <= count; i += 8){
+		__m256 earliest = _mm256_add_ps(start, _mm256_ceil_ps(_mm256_loadu_ps(&batch.pickupDistance[i])));
+		__m256 latest = _mm256_add_ps(earliest, radius);
+		__m256 time = _mm256_loadu_ps(&batch.requestTime[i]);
+		__m256 inWindow = _mm256_and_ps(_mm256_cmp_ps(time, earliest, _CMP_GE_OQ), _mm256_cmp_ps(time, latest, _CMP_LE_OQ));
+		_mm256_storeu_si256((__m256i*)&batch.feasible[i], _mm256_castps_si256(inWindow));
+	}
+#elif defined(SCORING_KERNEL_SSE)
+	__m128 start = _mm_set1_ps((float)timeToUse);
+	__m128 radius = _mm_set1_ps((float)timeRadius);
+	__m128 one = _mm_set1_ps(1);
+	for (; i + 4 <= count; i += 4){
+		//SSE2 has no ceil: truncate, then add one where truncation went down. Distances are never negative.
+		__m128 distance = _mm_loadu_ps(&batch.pickupDistance[i]);
+		__m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(distance));
+		__m128 ceiling = _mm_add_ps(truncated, _mm_and_ps(_mm_cmplt_ps(truncated, distance), one));
+		__m128 earliest = _mm_add_ps(start, ceiling);
+		__m128 latest = _mm_add_ps(earliest, radius);
+		__m128 time = _mm_loadu_ps(&batch.requestTime[i]);
+		__m128 inWindow = _mm_and_ps(_mm_cmpge_ps(time, earliest), _mm_cmple_ps(time, latest));
+		_mm_storeu_si128((__m128i*)&batch.feasible[i], _mm_castps_si128(inWindow));
+	}
+#endif
+	for (; i < count; i++){
+		float earliest = timeToUse + ceilf(batch.pickupDistance[i]);
+		float latest = earliest + timeRadius;
+		batch.feasible[i] = batch.requestTime[i] >= earliest && batch.requestTime[i] <= latest ? -1 : 0;
+	}
+}
+
+void scoreCandidates(CandidateBatch& batch, float weightOfDistanceOfRide, int maxRideRequests){
+	size_t count = batch.size();
+	batch.score.resize(count);
+	//Integer division, as in the single request formula: the penalty only shrinks once the ceiling is 3 or less.
+	float penaltyStep = maxRideRequests > 0 ? (float)(3 / maxRideRequests) : 0;
+	size_t i = 0;
+#if defined(SCORING_KERNEL_AVX)
+	__m256 ten = _mm256_set1_ps(10);
+	__m256 three = _mm256_set1_ps(3);
+	__m256 weight = _mm256_set1_ps(weightOfDistanceOfRide);
+	__m256 ceiling = _mm256_set1_ps((float)maxRideRequests);
+	__m256 step = _mm256_set1_ps(penaltyStep);
+	__m256 infeasibleScore = _mm256_set1_ps(-1);
+	for (; i + 8 <= count; i += 8){
+		__m256 pickup = _mm256_loadu_ps(&batch.pickupDistance[i]);
+		__m256 ride = _mm256_loadu_ps(&batch.rideDistance[i]);
+		__m256 requests = _mm256_loadu_ps(&batch.requestsAtDestination[i]);
+		__m256 utilization = _mm256_mul_ps(_mm256_div_ps(ride, _mm256_add_ps(pickup, ride)), ten);
+		__m256 rideValue = _mm256_mul_ps(_mm256_mul_ps(ride, weight), ten);
+		__m256 penalty = _mm256_and_ps(_mm256_cmp_ps(requests, ceiling, _CMP_LT_OQ), _mm256_sub_ps(three, _mm256_mul_ps(requests, step)));
+		__m256 score = _mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(utilization, rideValue), penalty), ten);
+		__m256 feasible = _mm256_castsi256_ps(_mm256_loadu_si256((__m256i*)&batch.feasible[i]));
+		_mm256_storeu_ps(&batch.score[i], _mm256_blendv_ps(infeasibleScore, score, feasible));
+	}
+#elif defined(SCORING_KERNEL_SSE)
+	__m128 ten = _mm_set1_ps(10);
+	__m128 three = _mm_set1_ps(3);
+	__m128 weight = _mm_set1_ps(weightOfDistanceOfRide);
+	__m128 ceiling = _mm_set1_ps((float)maxRideRequests);
+	__m128 step = _mm_set1_ps(penaltyStep);
+	__m128 infeasibleScore = _mm_set1_ps(-1);
+	for (; i + 4 <= count; i += 4){
+		__m128 pickup = _mm_loadu_ps(&batch.pickupDistance[i]);
+		__m128 ride = _mm_loadu_ps(&batch.rideDistance[i]);
+		__m128 requests = _mm_loadu_ps(&batch.requestsAtDestination[i]);
+		__m128 utilization = _mm_mul_ps(_mm_div_ps(ride, _mm_add_ps(pickup, ride)), ten);
+		__m128 rideValue = _mm_mul_ps(_mm_mul_ps(ride, weight), ten);
+		__m128 penalty = _mm_and_ps(_mm_cmplt_ps(requests, ceiling), _mm_sub_ps(three, _mm_mul_ps(requests, step)));
+		__m128 score = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(utilization, rideValue), penalty), ten);
+		__m128 feasible = _mm_castsi128_ps(_mm_loadu_si128((__m128i*)&batch.feasible[i]));
+		_mm_storeu_ps(&batch.score[i], _mm_or_ps(_mm_and_ps(feasible, score), _mm_andnot_ps(feasible, infeasibleScore)));
+	}
+#endif
+	for (; i < count; i++){
+		if (!batch.feasible[i]){
+			batch.score[i] = -1;
+			continue;
+		}
+		float percentageUtilization = (batch.rideDistance[i] / (batch.pickupDistance[i] + batch.rideDistance[i])) * 10;
+		float rideDistanceValue = ((batch.rideDistance[i]) * (weightOfDistanceOfRide)) * 10;
+		float destinationPenalty = 0;
+		if (batch.requestsAtDestination[i] < maxRideRequests){
+			destinationPenalty = 3 - (batch.requestsAtDestination[i] * penaltyStep);
+		}
+		batch.score[i] = (percentageUtilization + rideDistanceValue - destinationPenalty) * 10;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef _SCORING_KERNEL_H
+#define _SCORING_KERNEL_H
+#include <vector>
+#include <stddef.h>
+#include "RoutingPolicy.h"
+#include "RideRequestStore.h"
+
+//Candidate requests of one vehicle stored as parallel arrays so they can be scored several at a time.
+struct CandidateBatch{
+	std::vector<float> pickupLatitude, pickupLongitude;
+	std::vector<float> destinationLatitude, destinationLongitude;
+	//Ride distance already recorded on the request, or -1 when it still has to be calculated.
+	std::vector<float> cachedRideDistance;
+	std::vector<float> requestTime;
+	//Filled in by the caller for feasible candidates, between markFeasibleCandidates and scoreCandidates.
+	std::vector<float> requestsAtDestination;
+
+	std::vector<float> pickupDistance;
+	std::vector<float> rideDistance;
+	std::vector<int> feasible;
+	std::vector<float> score;
+
+	void clear();
+	void addCandidate(RideRequestStore& rideRequests, RequestId request);
+	size_t size(){ return requestTime.size(); }
+};
+
+//One candidate's scoring values, kept once the batch it was scored in is reused.
+struct ScoredCandidate{
+	RequestId request;
+	float pickupDistance;
+	float rideDistance;
+	float requestsAtDestination;
+};
+
+//Pickup and ride distance of the candidates from index first onwards, one at a time.
+template<class Routing>
+inline void computeRemainingDistances(CandidateBatch& batch, size_t first, float vehicleLatitude, float vehicleLongitude){
+	for (size_t i = first; i < batch.size(); i++){
+		batch.pickupDistance[i] = Routing::distance(vehicleLatitude, vehicleLongitude, batch.pickupLatitude[i], batch.pickupLongitude[i]);
+		if (batch.cachedRideDistance[i] < 0){
+			batch.rideDistance[i] = Routing::distance(batch.pickupLatitude[i], batch.pickupLongitude[i], batch.destinationLatitude[i], batch.destinationLongitude[i]);
+		}
+		else{
+			batch.rideDistance[i] = batch.cachedRideDistance[i];
+		}
+	}
+}
+
+//Pickup distance from the vehicle and ride distance of every candidate, measured by the routing policy.
+template<class Routing>
+inline void computeCandidateDistances(CandidateBatch& batch, float vehicleLatitude, float vehicleLongitude){
+	batch.pickupDistance.resize(batch.size());
+	batch.rideDistance.resize(batch.size());
+	computeRemainingDistances<Routing>(batch, 0, vehicleLatitude, vehicleLongitude);
+}
+
+//Euclidean and Manhattan distances are computed several candidates at a time.
+template<> void computeCandidateDistances<EuclideanRouting>(CandidateBatch& batch, float vehicleLatitude, float vehicleLongitude);
+template<> void computeCandidateDistances<ManhattanRouting>(CandidateBatch& batch, float vehicleLatitude, float vehicleLongitude);
+
+//A candidate is feasible when its request time falls in [arrival, arrival + timeRadius], where arrival is the tick the
+//vehicle would reach the pickup.
+void markFeasibleCandidates(CandidateBatch& batch, int timeToUse, int timeRadius);
+
+//Scores every candidate with the same formula as a single request; infeasible candidates score -1.
+void scoreCandidates(CandidateBatch& batch, float weightOfDistanceOfRide, int maxRideRequests);
+
+#endif
\ No newline at end of file
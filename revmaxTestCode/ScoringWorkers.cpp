@@ -0,0 +1,9 @@
+#include "ScoringWorkers.h"
+
+ScoringWorkers::ScoringWorkers(unsigned threadCount) : scheduler(threadCount)
+{
+	//A few chunks per thread, so a thread that draws the busy part of the map does not hold up the rest.
+	size_t chunks = scheduler.getThreadCount() * 4;
+	chunkCandidates.resize(chunks);
+	chunkBatches.resize(chunks);
+}
@@ -0,0 +1,64 @@
+#ifndef _SCORING_WORKERS_H
+#define _SCORING_WORKERS_H
+#include <vector>
+#include <algorithm>
+#include <stddef.h>
+#include "ScoringKernel.h"
+#include "TestScheduler.h"
+
+//One idle vehicle's pick for a tick, made against the open requests as they stood when its round began.
+struct RequestProposal{
+	int vehicle;
+	float score;
+	ScoredCandidate candidate;
+};
+
+//Order proposals are committed in: highest score first, ties going to the vehicle earliest in the fleet.
+//It depends on nothing but the proposals, so the matches made do not depend on how the scoring was split up.
+inline bool proposalComesFirst(const RequestProposal& a, const RequestProposal& b){
+	if (a.score != b.score){
+		return a.score > b.score;
+	}
+	return a.vehicle < b.vehicle;
+}
+
+//Threads that score the vehicles of one test side by side. Each chunk of vehicles gets its own candidate list and batch,
+//so scoring only has to read the requests and the request manager.
+class ScoringWorkers
+{
+protected:
+	TestScheduler scheduler;
+	std::vector<std::vector<RequestId>> chunkCandidates;
+	std::vector<CandidateBatch> chunkBatches;
+public:
+	//A thread count of 0 uses one thread per hardware thread.
+	ScoringWorkers(unsigned threadCount);
+
+	//Calls score(i, candidates, batch) for every i below count and returns once all calls have finished.
+	template<class Score>
+	inline void forEach(size_t count, Score score){
+		size_t chunks = std::min(count, chunkBatches.size());
+		if (chunks <= 1){
+			for (size_t i = 0; i < count; i++){
+				score(i, chunkCandidates[0], chunkBatches[0]);
+			}
+			return;
+		}
+		for (size_t chunk = 0; chunk < chunks; chunk++){
+			size_t begin = count * chunk / chunks;
+			size_t end = count * (chunk + 1) / chunks;
+			std::vector<RequestId>* candidates = &chunkCandidates[chunk];
+			CandidateBatch* batch = &chunkBatches[chunk];
+			scheduler.addTask([=](){
+				for (size_t i = begin; i < end; i++){
+					score(i, *candidates, *batch);
+				}
+			}, (double)(end - begin));
+		}
+		scheduler.runAll();
+	}
+
+	size_t getThreadCount(){ return scheduler.getThreadCount(); }
+};
+
+#endif
@@ -0,0 +1,1537 @@
+#ifndef _SIMULATION_CORE_H
+#define _SIMULATION_CORE_H
+
+#include "RequestManager.h"
+#include "RideRequestStore.h"
+#include "Vehicle.h"
+#include "ScoringKernel.h"
+#include "RoutingPolicy.h"
+#include "mathHelper.h"
+#include "TestScheduler.h"
+#include "TestContext.h"
+#include "EventQueue.h"
+#include "FleetSchedule.h"
+#include "BatchAssignment.h"
+#include "ScoringWorkers.h"
+#include "TileGrid.h"
+#ifdef _WIN32
+#include "dirent.h"
+#else
+#include <dirent.h>
+#endif
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "MappedFile.h"
+#include "XmlStream.h"
+#include "ScenarioFile.h"
+#include "ResultsTable.h"
+#include "ExcelStreamWriter.h"
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <random>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64) || defined(WIN82) || defined(_WIN82)
+#define RESOURCE_FOLDER ""
+#else
+#define RESOURCE_FOLDER "NYUCodebase.app/Contents/Resources/"
+#endif
+
+//Loads tests, runs them and writes their results. Nothing here depends on SDL or OpenGL,
+//so it can be driven by the Simulator window or by the headless batch runner.
+class SimulationCore{
+protected:
+	//Tests in the order they were added, so a test's index is its test number.
+	std::vector<TestContext*> tests;
+	std::unordered_map<std::string, TestContext*> testsByName;
+	std::vector<std::string> testNames;
+	TestContext* currentTest;
+	std::string excelFileName;
+	//Set when this process runs one shard of a ranged sweep: its results go to this file instead of the spreadsheet.
+	std::string shardFileName;
+	//Set when custom and ranged tests take their vehicles and requests from a file instead of drawing them.
+	std::string scenarioFile;
+	std::string resultsFolder;
+	std::string aggregateResultsFolder;
+	bool runningRanged;
+	//Set when nothing reads a test's requests and vehicles once its results are stored, as with the batch runner.
+	bool freeFinishedTests;
+	//Test n draws from stream n of this seed, so the same seed gives the same tests.
+	uint64_t randomSeed;
+	//The start of stream testStreamNumber of randomSeed. Adding a test moves it on one stream, so setting up a sweep
+	//costs a jump per test rather than jumps from the seed's first stream every time.
+	RandomStream testStream;
+	size_t testStreamNumber;
+	//How tests that are not part of a ranged sweep report their results: a text report per test, or a row per test in
+	//results.csv in the results folder, and with vehicleResults a row per vehicle in vehicles.csv.
+	RESULTS_FORMAT resultsFormat;
+	bool vehicleResults;
+	ResultsTable testResultsTable;
+	ResultsTable vehicleResultsTable;
+	//The spreadsheet of a ranged sweep, which each test adds its row to as it finishes.
+	ExcelStreamWriter resultsWorkbook;
+
+	//Adds a test with the default parameters and makes it the current test.
+	inline TestContext* addTest(const std::string& testName){
+		currentTest = new TestContext(testName);
+		if (tests.size() < testStreamNumber){
+			restartTestStreams();
+		}
+		for (; testStreamNumber < tests.size(); testStreamNumber++){
+			testStream.jump();
+		}
+		currentTest->random = testStream;
+		tests.push_back(currentTest);
+		testsByName[testName] = currentTest;
+		testNames.push_back(testName);
+		return currentTest;
+	}
+
+	inline void restartTestStreams(){
+		testStream = RandomStream(randomSeed);
+		testStreamNumber = 0;
+	}
+
+	inline TestContext* getTest(const std::string& testName){
+		std::unordered_map<std::string, TestContext*>::iterator test = testsByName.find(testName);
+		if (test == testsByName.end()){
+			throw "No test with that name!";
+		}
+		return test->second;
+	}
+
+	//Called whenever a test's request manager is created, before any request is added to it.
+	virtual void managerCreated(RequestManager*){}
+
+	//Scores all of a vehicle's candidates as one batch, without touching the vehicle or the requests.
+	template<class Routing>
+	inline void scoreVehicleCandidates(Vehicle* vehicle, std::vector<RequestId>& candidates, CandidateBatch& batch, RequestManager* manager, int time, int timeRadius, float weightOfDistanceOfRide, int maxRideRequests){
+		RideRequestStore& rideRequests = manager->getRideRequests();
+		//Assumption: each mile is travelled in one hour.
+		//When travelling by routing in a city, what is a short distance suddenly becomes an incredibly long distance.
+		int timeToUse = time;
+		if (vehicle->getTopRequest() != NO_REQUEST){
+			timeToUse = rideRequests.getRequestTime(vehicle->getTopRequest()) + rideRequests.getDistanceOfRequest(vehicle->getTopRequest());
+		}
+		batch.clear();
+		for (RequestId request : candidates){
+			batch.addCandidate(rideRequests, request);
+		}
+		computeCandidateDistances<Routing>(batch, vehicle->getCurrentLocation().first, vehicle->getCurrentLocation().second);
+		markFeasibleCandidates(batch, timeToUse, timeRadius);
+		for (size_t i = 0; i < batch.size(); i++){
+			if (batch.feasible[i]){
+				//Currently using the calculated distance as the time.
+				int timeOfRide = (int)batch.rideDistance[i];
+				batch.requestsAtDestination[i] = manager->getNumberOfRequestsAtLocation(rideRequests.getDestination(candidates[i]), rideRequests.getRequestTime(candidates[i]) + timeOfRide);
+			}
+		}
+		scoreCandidates(batch, weightOfDistanceOfRide, maxRideRequests);
+	}
+
+	//Returns the index of the vehicle's best candidate scoring above topScore, or -1 if there is none.
+	template<class Routing>
+	inline int findTopCandidate(Vehicle* vehicle, std::vector<RequestId>& candidates, CandidateBatch& batch, RequestManager* manager, int time, int timeRadius, float weightOfDistanceOfRide, int maxRideRequests, float topScore){
+		scoreVehicleCandidates<Routing>(vehicle, candidates, batch, manager, time, timeRadius, weightOfDistanceOfRide, maxRideRequests);
+		int topCandidate = -1;
+		for (size_t i = 0; i < batch.size(); i++){
+			if (batch.score[i] > topScore){
+				topScore = batch.score[i];
+				topCandidate = i;
+			}
+		}
+		return topCandidate;
+	}
+
+	//Only the request a vehicle is matched to keeps the values it was scored with.
+	inline void recordRequestScore(RideRequestStore& rideRequests, ScoredCandidate& candidate){
+		rideRequests.setDistanceToRequest(candidate.request, ceil(candidate.pickupDistance));
+		rideRequests.setDistanceOfRequest(candidate.request, candidate.rideDistance);
+		rideRequests.setRequestsAtDestination(candidate.request, candidate.requestsAtDestination);
+	}
+
+	inline void matchRequest(RequestManager* manager, Vehicle* vehicle, RequestId request, int time){
+		vehicle->addRequest(request);
+		manager->setMatchedToVehicle(request, true);
+		manager->getRideRequests().setTimeMatched(request, time);
+	}
+
+	//Reads a location's lat and long attributes.
+	inline std::pair<float, float> readLocation(XmlStream& xml){
+		const XmlText* latitude = xml.getAttribute("lat");
+		const XmlText* longitude = xml.getAttribute("long");
+		if (longitude == nullptr || latitude == nullptr){
+			throw "No latitude or longitude!";
+		}
+		return std::make_pair(latitude->toFloat(), longitude->toFloat());
+	}
+
+	//Reads the rest of a Request element. Only the first Location, Destination and RequestTime count, as before.
+	inline void readRequest(TestContext& test, XmlStream& xml){
+		std::pair<float, float> location, destination;
+		bool hasLocation = false, hasDestination = false, hasTime = false;
+		int time = 0;
+		while (xml.nextElement()){
+			if (!hasLocation && xml.isNamed("Location")){
+				location = readLocation(xml);
+				hasLocation = true;
+				xml.skipElement();
+			}
+			else if (!hasDestination && xml.isNamed("Destination")){
+				destination = readLocation(xml);
+				hasDestination = true;
+				xml.skipElement();
+			}
+			else if (!hasTime && xml.isNamed("RequestTime")){
+				time = xml.readText().toInt();
+				hasTime = true;
+			}
+			else{
+				xml.skipElement();
+			}
+		}
+		if (!hasLocation){
+			throw "No request location!";
+		}
+		if (!hasDestination){
+			throw "No request destination!";
+		}
+		if (!hasTime){
+			throw "No time specified for request!";
+		}
+		test.manager->addRequest(std::make_pair((long)location.first, (long)location.second), std::make_pair((long)destination.first, (long)destination.second), time);
+	}
+
+	inline void createRandomRequest(TestContext& test, float minLat, float minLong, float maxLat, float maxLong){
+		float locLat, locLong;
+		float destLat, destLong;
+		int time;
+		RandomStream& random = test.random;
+		locLat = random.nextFloat(minLat, maxLat);
+		locLong = random.nextFloat(minLong, maxLong);
+		destLat = random.nextFloat(minLat, maxLat);
+		destLong = random.nextFloat(minLong, maxLong);
+		time = random.nextInt(0, test.timesToRun);
+
+		test.manager->addRequest(std::make_pair((long)locLat, (long)locLong), std::make_pair((long)destLat, (long)destLong), time);
+	}
+
+	inline Vehicle* addVehicle(TestContext& test, long latitude, long longitude){
+		Vehicle* vehicle = test.vehiclePool.create();
+		vehicle->setStartingLocation(latitude, longitude);
+		test.vehicles.push_back(vehicle);
+		return vehicle;
+	}
+
+	//Reads the rest of a Vehicle element.
+	inline void readVehicle(TestContext& test, XmlStream& xml){
+		std::pair<float, float> location;
+		bool hasLocation = false;
+		while (xml.nextElement()){
+			if (!hasLocation && xml.isNamed("Location")){
+				location = readLocation(xml);
+				hasLocation = true;
+			}
+			xml.skipElement();
+		}
+		if (!hasLocation){
+			throw "No location!";
+		}
+
+		addVehicle(test, location.first, location.second);
+	}
+
+	inline void createRandomVehicle(TestContext& test, float minLat, float minLong, float maxLat, float maxLong){
+		float locLat, locLong;
+		locLat = test.random.nextFloat(minLat, maxLat);
+		locLong = test.random.nextFloat(minLong, maxLong);
+		addVehicle(test, locLat, locLong);
+	}
+
+	inline void readManager(TestContext& test, XmlStream& xml){
+		int minLat = 0, minLong = 0;
+		int maxLat = 20, maxLong = 20;
+		int sectionSize = 5;
+
+		if (xml.getAttribute("minLat") != nullptr){
+			minLat = xml.getAttribute("minLat")->toInt();
+		}
+
+		if (xml.getAttribute("minLong") != nullptr){
+			minLong = xml.getAttribute("minLong")->toInt();
+		}
+
+		if (xml.getAttribute("maxLat") != nullptr){
+			maxLat = xml.getAttribute("maxLat")->toInt();
+		}
+
+		if (xml.getAttribute("maxLong") != nullptr){
+			maxLong = xml.getAttribute("maxLong")->toInt();
+		}
+
+		if (xml.getAttribute("sectionSize") != nullptr){
+			sectionSize = xml.getAttribute("sectionSize")->toInt();
+		}
+
+		createManager(test, minLat, minLong, maxLat, maxLong, sectionSize);
+	}
+
+	inline void createManager(TestContext& test, int minLat, int minLong, int maxLat, int maxLong, int sectionSize){
+		test.manager = new RequestManager();
+
+		test.manager->setLatitudeMin(minLat);
+		test.manager->setLongitudeMin(minLong);
+		test.manager->setLatitudeMax(maxLat);
+		test.manager->setLongitudeMax(maxLong);
+		test.manager->setSectionRadius(sectionSize);
+		test.manager->initializeRequestMap();
+
+		managerCreated(test.manager);
+	}
+
+	inline void createManagerFromParams(TestContext& test, float maxLong, float maxLat, float sectionSize){
+		test.manager = new RequestManager();
+		test.manager->setLatitudeMin(0);
+		test.manager->setLongitudeMin(0);
+		test.manager->setLatitudeMax(maxLat);
+		test.manager->setLongitudeMax(maxLong);
+		test.manager->setSectionRadius(sectionSize);
+		test.manager->initializeRequestMap();
+
+		managerCreated(test.manager);
+	}
+
+	//Copies the requests and vehicles of a test that has not run yet into a scenario other tests can share.
+	inline std::shared_ptr<const Scenario> captureScenario(TestContext& test, float maxLat, float maxLong, float sectionSize){
+		std::shared_ptr<Scenario> scenario = std::make_shared<Scenario>();
+		scenario->maxLat = maxLat;
+		scenario->maxLong = maxLong;
+		scenario->sectionSize = sectionSize;
+		captureRecords(test, scenario->requestRecords, scenario->vehicleRecords);
+		scenario->requests = scenario->requestRecords.data();
+		scenario->requestCount = scenario->requestRecords.size();
+		scenario->vehicles = scenario->vehicleRecords.data();
+		scenario->vehicleCount = scenario->vehicleRecords.size();
+		return scenario;
+	}
+
+	//Copies the requests and vehicles of a test that has not run yet into the records scenarios are made of.
+	inline void captureRecords(TestContext& test, std::vector<ScenarioRequest>& requests, std::vector<ScenarioVehicle>& vehicles){
+		RideRequestStore& rideRequests = test.manager->getRideRequests();
+		requests.resize(rideRequests.size());
+		for (RequestId request = 0; request < (RequestId)rideRequests.size(); request++){
+			ScenarioRequest& record = requests[request];
+			record.locationLat = rideRequests.getLocation(request).first;
+			record.locationLong = rideRequests.getLocation(request).second;
+			record.destinationLat = rideRequests.getDestination(request).first;
+			record.destinationLong = rideRequests.getDestination(request).second;
+			record.requestTime = rideRequests.getRequestTime(request);
+		}
+		vehicles.resize(test.vehicles.size());
+		for (size_t i = 0; i < test.vehicles.size(); i++){
+			vehicles[i].latitude = test.vehicles[i]->getCurrentLocation().first;
+			vehicles[i].longitude = test.vehicles[i]->getCurrentLocation().second;
+		}
+	}
+
+	//Maps a binary scenario file as a scenario, using its arrays where they lie. Like a scenario read from a test file,
+	//it gives only requests and vehicles: the map comes from the parameters given here.
+	inline std::shared_ptr<const Scenario> mapScenario(const std::shared_ptr<MappedFile>& file, float maxLat, float maxLong, float sectionSize){
+		std::shared_ptr<Scenario> scenario = std::make_shared<Scenario>();
+		scenario->maxLat = maxLat;
+		scenario->maxLong = maxLong;
+		scenario->sectionSize = sectionSize;
+		scenario->file = file;
+		const ScenarioFileHeader& header = readScenarioFileHeader(*scenario->file);
+		scenario->requests = getScenarioRequests(*scenario->file);
+		scenario->requestCount = header.requestCount;
+		scenario->vehicles = getScenarioVehicles(*scenario->file);
+		scenario->vehicleCount = header.vehicleCount;
+		return scenario;
+	}
+
+	//Adds the requests and vehicles of scenario records to a test that has its request manager.
+	inline void addRecords(TestContext& test, const ScenarioRequest* requests, size_t requestCount, const ScenarioVehicle* vehicles, size_t vehicleCount){
+		test.manager->getRideRequests().reserve(requestCount);
+		for (size_t i = 0; i < requestCount; i++){
+			const ScenarioRequest& request = requests[i];
+			test.manager->addRequest(std::make_pair((long)request.locationLat, (long)request.locationLong), std::make_pair((long)request.destinationLat, (long)request.destinationLong), request.requestTime);
+		}
+		test.vehicles.reserve(vehicleCount);
+		test.vehiclePool.reserve(vehicleCount);
+		for (size_t i = 0; i < vehicleCount; i++){
+			addVehicle(test, vehicles[i].latitude, vehicles[i].longitude);
+		}
+	}
+
+	//Gives a test of a ranged sweep its own request manager, requests and vehicles, built from the scenario it shares.
+	inline void buildFromScenario(TestContext& test){
+		const Scenario& scenario = *test.scenario;
+		createManagerFromParams(test, scenario.maxLong, scenario.maxLat, scenario.sectionSize);
+		addRecords(test, scenario.requests, scenario.requestCount, scenario.vehicles, scenario.vehicleCount);
+	}
+
+	//Frees a test's request manager, requests and vehicles. Its parameters and results stay.
+	inline void releaseTestState(TestContext& test){
+		if (test.manager != nullptr){
+			test.manager->freeMemory();
+			delete test.manager;
+			test.manager = nullptr;
+		}
+		test.vehicles.clear();
+		test.vehiclePool.clear();
+	}
+
+	//Reads the Parameters element's attributes into a test.
+	inline void readParameters(TestContext& test, XmlStream& xml){
+		if (xml.getAttribute("WeightOfDistanceOfTrip") != nullptr){
+			test.weightOfDistanceOfTrip = xml.getAttribute("WeightOfDistanceOfTrip")->toFloat();
+		}
+		if (xml.getAttribute("TimesToRun") != nullptr){
+			test.timesToRun = xml.getAttribute("TimesToRun")->toInt();
+		}
+		if (xml.getAttribute("MinRadius") != nullptr){
+			test.radiusMin = xml.getAttribute("MinRadius")->toInt();
+		}
+		if (xml.getAttribute("RadiusStep") != nullptr){
+			test.radiusMin = xml.getAttribute("RadiusStep")->toInt();
+		}
+		if (xml.getAttribute("MaxRadius") != nullptr){
+			test.radiusMin = xml.getAttribute("MaxRadius")->toInt();
+		}
+		if (xml.getAttribute("TimeRadius") != nullptr){
+			test.timeRadius = xml.getAttribute("TimeRadius")->toInt();
+		}
+		if (xml.getAttribute("MinimumScore") != nullptr){
+			test.minimumScore = xml.getAttribute("MinimumScore")->toFloat();
+		}
+		if (xml.getAttribute("MaxRideRequests") != nullptr){
+			test.maxRideRequests = xml.getAttribute("MaxRideRequests")->toInt();
+		}
+		if (xml.getAttribute("RoutingMetric") != nullptr){
+			test.routingMetric = parseRoutingMetric(xml.getAttribute("RoutingMetric")->toString());
+		}
+		if (xml.getAttribute("SimulationMode") != nullptr){
+			test.simulationMode = parseSimulationMode(xml.getAttribute("SimulationMode")->toString());
+		}
+		if (xml.getAttribute("DispatchMode") != nullptr){
+			test.dispatchMode = parseDispatchMode(xml.getAttribute("DispatchMode")->toString());
+		}
+		if (xml.getAttribute("ScoringThreads") != nullptr){
+			test.scoringThreads = xml.getAttribute("ScoringThreads")->toInt();
+		}
+	}
+
+	//Reads a file in the test file format into a test in one pass over the mapped file. Requests and vehicles
+	//go straight into the test as they are read, so no copy of the file is ever built, which lets very large scenarios load.
+	//The request manager must come before the requests. A scenario, which is all a file in the test file format is when
+	//custom and ranged tests use one, gives only its requests and vehicles: its parameters and request manager are not read
+	//and no random requests or vehicles are drawn for it.
+	inline void readTestFile(TestContext& test, MappedFile& file, bool scenario){
+		XmlStream xml(file.begin(), file.end());
+		bool hasParameters = false;
+		while (!hasParameters && xml.nextElement()){
+			hasParameters = xml.isNamed("Parameters");
+			if (!hasParameters){
+				xml.skipElement();
+			}
+		}
+		if (!hasParameters){
+			throw scenario ? "No requests!" : "Empty file!";
+		}
+		if (!scenario){
+			readParameters(test, xml);
+		}
+
+		int fleetSize = 0, requestCount = 0;
+		bool hasManager = scenario, hasRequests = false, hasVehicles = false;
+		while (xml.nextElement()){
+			if (!hasManager && xml.isNamed("RequestManager")){
+				readManager(test, xml);
+				hasManager = true;
+				xml.skipElement();
+			}
+			else if (!hasRequests && xml.isNamed("Requests")){
+				if (!hasManager){
+					throw "No request manager!";
+				}
+				if (!scenario && xml.getAttribute("requestCount") != nullptr){
+					requestCount = xml.getAttribute("requestCount")->toInt();
+				}
+				while (xml.nextElement()){
+					if (xml.isNamed("Request")){
+						readRequest(test, xml);
+						if (requestCount > 0){
+							requestCount--;
+						}
+					}
+					else{
+						xml.skipElement();
+					}
+				}
+				hasRequests = true;
+			}
+			else if (!hasVehicles && xml.isNamed("Vehicles")){
+				if (!hasManager){
+					throw "No request manager!";
+				}
+				if (!scenario && xml.getAttribute("fleetSize") != nullptr){
+					fleetSize = xml.getAttribute("fleetSize")->toInt();
+				}
+				while (xml.nextElement()){
+					if (xml.isNamed("Vehicle")){
+						readVehicle(test, xml);
+						if (fleetSize > 0){
+							fleetSize--;
+						}
+					}
+					else{
+						xml.skipElement();
+					}
+				}
+				hasVehicles = true;
+			}
+			else{
+				xml.skipElement();
+			}
+		}
+		if (!hasManager){
+			throw "No request manager!";
+		}
+		if (!hasRequests){
+			throw "No requests!";
+		}
+		if (!hasVehicles){
+			throw "No vehicles!";
+		}
+
+		//Random requests are drawn before random vehicles, wherever the two lists sit in the file.
+		while (requestCount > 0){
+			createRandomRequest(test, test.manager->getMinCoords().first, test.manager->getMinCoords().second, test.manager->getMaxCoords().first, test.manager->getMaxCoords().second);
+			requestCount--;
+		}
+		while (fleetSize > 0){
+			createRandomVehicle(test, test.manager->getMinCoords().first, test.manager->getMinCoords().second, test.manager->getMaxCoords().first, test.manager->getMaxCoords().second);
+			fleetSize--;
+		}
+	}
+
+	//Adds the vehicles and requests of a file in the test file format to the current test. Its parameters are not read.
+	inline void loadScenario(const std::string& filePath){
+		MappedFile file(filePath);
+		if (isScenarioFile(file)){
+			const ScenarioFileHeader& header = readScenarioFileHeader(file);
+			addRecords(*currentTest, getScenarioRequests(file), header.requestCount, getScenarioVehicles(file), header.vehicleCount);
+		}
+		else{
+			readTestFile(*currentTest, file, true);
+		}
+	}
+
+	//Reads a binary scenario file into a test, parameters and all, as if it were the test file it was exported from.
+	inline void readScenarioTest(TestContext& test, MappedFile& file){
+		const ScenarioFileHeader& header = readScenarioFileHeader(file);
+		test.weightOfDistanceOfTrip = header.weightOfDistanceOfTrip;
+		test.timesToRun = header.timesToRun;
+		test.radiusMin = header.radiusMin;
+		test.radiusStep = header.radiusStep;
+		test.radiusMax = header.radiusMax;
+		test.timeRadius = header.timeRadius;
+		test.minimumScore = header.minimumScore;
+		test.maxRideRequests = header.maxRideRequests;
+		if (header.routingMetric != ROUTING_EUCLIDEAN && header.routingMetric != ROUTING_MANHATTAN && header.routingMetric != ROUTING_GRID_GRAPH){
+			throw "Unknown routing metric!";
+		}
+		test.routingMetric = (ROUTING_METRIC)header.routingMetric;
+		if (header.simulationMode != SIMULATION_TICKS && header.simulationMode != SIMULATION_EVENTS && header.simulationMode != SIMULATION_TILES){
+			throw "Unknown simulation mode!";
+		}
+		test.simulationMode = (SIMULATION_MODE)header.simulationMode;
+		if (header.dispatchMode != DISPATCH_GREEDY && header.dispatchMode != DISPATCH_BATCH && header.dispatchMode != DISPATCH_PARALLEL){
+			throw "Unknown dispatch mode!";
+		}
+		test.dispatchMode = (DISPATCH_MODE)header.dispatchMode;
+		test.scoringThreads = header.scoringThreads;
+		createManager(test, header.minLat, header.minLong, header.maxLat, header.maxLong, header.sectionSize);
+		addRecords(test, getScenarioRequests(file), header.requestCount, getScenarioVehicles(file), header.vehicleCount);
+	}
+
+	inline void initialize(const std::string& customTestName, unsigned customTimesToRun, float customTripWeight, float customRadiusMin, float customRadiusStep,
+		float customRadiusMax, float customTimeRadius, float customMinimumScore, unsigned customMaximumRideRequests, unsigned customFleetSize, unsigned customRideCount,
+		float customMaxLat, float customMaxLong, float customSectionSize, bool ranged){
+		runningRanged = ranged;
+		addTest(customTestName);
+		currentTest->weightOfDistanceOfTrip = customTripWeight;
+		currentTest->timesToRun = customTimesToRun;
+		currentTest->radiusMin = customRadiusMin;
+		currentTest->radiusStep = customRadiusStep;
+		currentTest->radiusMax = customRadiusMax;
+		currentTest->timeRadius = customTimeRadius;
+		currentTest->minimumScore = customMinimumScore;
+		currentTest->maxRideRequests = customMaximumRideRequests;
+		currentTest->routingMetric = ROUTING_EUCLIDEAN;
+		//Later tests of a ranged sweep share the first test's scenario and only build from it when they run.
+		if (ranged && tests.size() > 1){
+			currentTest->scenario = tests[0]->scenario;
+			return;
+		}
+		if (ranged && !scenarioFile.empty()){
+			std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(scenarioFile);
+			//A binary scenario is shared where it is mapped, so the sweep never holds a copy of it, and sweeps in other
+			//processes read the same pages.
+			if (isScenarioFile(*file)){
+				currentTest->scenario = mapScenario(file, customMaxLat, customMaxLong, customSectionSize);
+				buildFromScenario(*currentTest);
+				return;
+			}
+		}
+		createManagerFromParams(*currentTest, customMaxLong, customMaxLat, customSectionSize);
+		if (!scenarioFile.empty()){
+			loadScenario(scenarioFile);
+		}
+		else{
+			currentTest->vehicles.reserve(customFleetSize);
+			currentTest->vehiclePool.reserve(customFleetSize);
+			currentTest->manager->getRideRequests().reserve(customRideCount);
+			for (unsigned i = 0; i < customFleetSize; i++){
+				createRandomVehicle(*currentTest, 0, 0, customMaxLat, customMaxLong);
+			}
+			for (unsigned i = 0; i < customRideCount; i++){
+				createRandomRequest(*currentTest, 0, 0, customMaxLat, customMaxLong);
+			}
+		}
+		if (ranged){
+			currentTest->scenario = captureScenario(*currentTest, customMaxLat, customMaxLong, customSectionSize);
+		}
+	}
+
+	//Runs a test with its routing metric chosen once, so the scoring loop is compiled for that metric.
+	inline bool runTest(int testNum){
+		TestContext& test = *tests[testNum];
+		if (test.manager == nullptr && test.scenario){
+			buildFromScenario(test);
+		}
+		bool completed;
+		switch (test.routingMetric){
+		case ROUTING_MANHATTAN:
+			completed = runTestWithRouting<ManhattanRouting>(test, testNum);
+			break;
+		case ROUTING_GRID_GRAPH:
+			completed = runTestWithRouting<GridGraphRouting>(test, testNum);
+			break;
+		default:
+			completed = runTestWithRouting<EuclideanRouting>(test, testNum);
+			break;
+		}
+		//Only tests running at the same time hold requests and vehicles, however long the sweep.
+		if (freeFinishedTests){
+			releaseTestState(test);
+		}
+		return completed;
+	}
+
+	//Moves a vehicle along its request and drops the request off once the vehicle reaches the destination.
+	//Returns where the vehicle was after moving.
+	inline std::pair<long, long> advanceVehicle(TestContext& test, Vehicle* vehicle, int time){
+		vehicle->update(time, test.timeRadius, test.manager);
+		std::pair<long, long> vehicleLocation = vehicle->getCurrentLocation();
+		if (vehicle->getTopRequest() != NO_REQUEST && vehicleLocation == test.manager->getRideRequests().getDestination(vehicle->getTopRequest())){
+			vehicle->setHasPassenger(false);
+			vehicle->popTopRequest();
+			vehicle->addToRoutingLog(time, vehicleLocation);
+			test.numberOfCompletedRequests++;
+		}
+		return vehicleLocation;
+	}
+
+	//The request greedy dispatch would give the vehicle, without matching it: the best above the minimum score in the nearest
+	//radius step that has one. Returns false if there is none. Only reads the vehicle, the requests and the request manager.
+	template<class Routing>
+	inline bool proposeRequest(TestContext& test, Vehicle* vehicle, std::pair<long, long> vehicleLocation, int time, std::vector<RequestId>& candidates, CandidateBatch& batch, ScoredCandidate& proposal, float& score){
+		RequestManager* manager = test.manager;
+		int searchedRing = -1;
+		for (int x = test.radiusMin; x <= test.radiusMax; x += test.radiusStep){
+			//Only the sections the wider radius adds are searched: the ones already searched scored too low.
+			int ring = manager->getRingForRadius(x);
+			if (ring <= searchedRing){
+				continue;
+			}
+			candidates.clear();
+			manager->getRequestsInRing(vehicleLocation, searchedRing + 1, ring, candidates);
+			searchedRing = ring;
+			if (candidates.empty()){
+				continue;
+			}
+			int topCandidate = findTopCandidate<Routing>(vehicle, candidates, batch, manager, time, test.timeRadius, test.weightOfDistanceOfTrip, test.maxRideRequests, test.minimumScore);
+			if (topCandidate != -1){
+				proposal.request = candidates[topCandidate];
+				proposal.pickupDistance = batch.pickupDistance[topCandidate];
+				proposal.rideDistance = batch.rideDistance[topCandidate];
+				proposal.requestsAtDestination = batch.requestsAtDestination[topCandidate];
+				score = batch.score[topCandidate];
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//Greedy dispatch: the vehicle takes the best request above the minimum score, searching outwards one radius step at a time.
+	template<class Routing>
+	inline void searchForRequest(TestContext& test, Vehicle* vehicle, std::pair<long, long> vehicleLocation, int time, std::vector<RequestId>& candidates, CandidateBatch& batch){
+		ScoredCandidate proposal;
+		float score;
+		if (proposeRequest<Routing>(test, vehicle, vehicleLocation, time, candidates, batch, proposal, score)){
+			recordRequestScore(test.manager->getRideRequests(), proposal);
+			matchRequest(test.manager, vehicle, proposal.request, time);
+		}
+	}
+
+	//Updates whether the vehicle carries a passenger, logging the pickup for rendering.
+	inline void recordVehicleState(TestContext& test, Vehicle* vehicle, std::pair<long, long> vehicleLocation, int time){
+		RideRequestStore& rideRequests = test.manager->getRideRequests();
+		RequestId request = vehicle->getTopRequest();
+		try{
+			if (request != NO_REQUEST && rideRequests.getPickedUp(request)){
+				if (!vehicle->getHasPassenger()){
+					//outputFile << "\t\tVehicle picked up request at Latitude: " << vehicleLocation.first << " and Longitude: " << vehicleLocation.second << " at T = " << time << '\n';
+					vehicle->setHasPassenger(true);
+					vehicle->addToRoutingLog(time, vehicleLocation);
+				}
+				else{
+					vehicle->setHasPassenger(true);
+					//outputFile << "\t\tVehicle en route to destination." << '\n';
+				}
+			}
+			else if (request != NO_REQUEST && !rideRequests.getPickedUp(request)){
+				if (vehicle->getCurrentLocation().first != rideRequests.getLocation(request).first && vehicle->getCurrentLocation().second != rideRequests.getLocation(request).second){
+					//outputFile << "\t\tVehicle en route to pickup." << '\n';
+					vehicle->setHasPassenger(false);
+				}
+				else{
+					vehicle->setHasPassenger(false);
+					//outputFile << "\t\tVehicle waiting at pickup for request." << '\n';
+				}
+			}
+			else if (request == NO_REQUEST){
+				//outputFile << "\t\tVehicle idling.";
+				vehicle->setHasPassenger(false);
+			}
+		}
+		catch (std::exception & e){
+			vehicle->popTopRequest();
+			//outputFile << "\t\tVehicle status unknown.";
+		}
+	}
+
+	//One vehicle's turn in a tick: moves it along its request, drops the request off once it reaches the destination, and looks
+	//for a new request while it has none.
+	template<class Routing>
+	inline void stepVehicle(TestContext& test, Vehicle* vehicle, int time, std::vector<RequestId>& candidates, CandidateBatch& batch){
+		std::pair<long, long> vehicleLocation = advanceVehicle(test, vehicle, time);
+		if (vehicle->getTopRequest() == NO_REQUEST){
+			searchForRequest<Routing>(test, vehicle, vehicleLocation, time, candidates, batch);
+		}
+		recordVehicleState(test, vehicle, vehicleLocation, time);
+	}
+
+	//Outermost ring of sections a vehicle's search reaches, or -1 if the test never searches.
+	inline int getSearchRing(TestContext& test){
+		int searchRing = -1;
+		for (int x = test.radiusMin; x <= test.radiusMax; x += test.radiusStep){
+			searchRing = std::max(searchRing, test.manager->getRingForRadius(x));
+		}
+		return searchRing;
+	}
+
+	//Earliest tick after time at which an idle vehicle's search could find something new: the first tick at which a request
+	//in its search area becomes reachable within its time window. Requests already reachable at time were scored and turned down,
+	//and their scores cannot rise unless a request time changes, which wakes every idle vehicle.
+	template<class Routing>
+	inline int nextRequestAppears(TestContext& test, Vehicle* vehicle, int time, int searchRing, std::vector<RequestId>& candidates, CandidateBatch& batch){
+		int timeRadius = test.timeRadius;
+		if (searchRing < 0 || timeRadius < 0){
+			return -1;
+		}
+		candidates.clear();
+		test.manager->getRequestsInRing(vehicle->getCurrentLocation(), 0, searchRing, candidates);
+		RideRequestStore& rideRequests = test.manager->getRideRequests();
+		batch.clear();
+		for (RequestId request : candidates){
+			batch.addCandidate(rideRequests, request);
+		}
+		computeCandidateDistances<Routing>(batch, vehicle->getCurrentLocation().first, vehicle->getCurrentLocation().second);
+		int next = -1;
+		for (size_t i = 0; i < batch.size(); i++){
+			//Same arithmetic as markFeasibleCandidates, solved for the time.
+			int opens = (int)(batch.requestTime[i] - ceilf(batch.pickupDistance[i]) - timeRadius);
+			if (opens > time && (next == -1 || opens < next)){
+				next = opens;
+			}
+		}
+		return next;
+	}
+
+	//Next tick after time at which stepVehicle would change a vehicle with a request, or -1 if it never will. Mirrors Vehicle::update.
+	inline int nextTripEventTime(TestContext& test, Vehicle* vehicle, int time){
+		RideRequestStore& rideRequests = test.manager->getRideRequests();
+		RequestId request = vehicle->getTopRequest();
+		int timeRadius = test.timeRadius;
+		int pickupTime = rideRequests.getTimeMatched(request) + rideRequests.getDistanceToRequest(request);
+		if (pickupTime < rideRequests.getRequestTime(request)){
+			pickupTime = rideRequests.getRequestTime(request);
+		}
+		if (!rideRequests.getPickedUp(request)){
+			//Already standing on the destination: the next tick drops the request without a pickup.
+			if (vehicle->getCurrentLocation() == rideRequests.getDestination(request)){
+				return time + 1;
+			}
+			if (pickupTime > time && pickupTime <= rideRequests.getRequestTime(request) + timeRadius){
+				return pickupTime;
+			}
+			return -1;
+		}
+		int dropOffTime = rideRequests.getDistanceOfRequest(request) + pickupTime;
+		int due = std::max(dropOffTime, time + 1);
+		return due <= dropOffTime + timeRadius ? due : -1;
+	}
+
+	//Next tick after time at which stepVehicle would change the vehicle, or -1 if it never will.
+	template<class Routing>
+	inline int nextEventTime(TestContext& test, Vehicle* vehicle, int time, int searchRing, std::vector<RequestId>& candidates, CandidateBatch& batch){
+		if (vehicle->getTopRequest() == NO_REQUEST){
+			return nextRequestAppears<Routing>(test, vehicle, time, searchRing, candidates, batch);
+		}
+		return nextTripEventTime(test, vehicle, time);
+	}
+
+	inline void rescheduleVehicle(FleetSchedule& schedule, TestContext& test, int vehicleNum, int time){
+		Vehicle* vehicle = test.vehicles[vehicleNum];
+		if (vehicle->getTopRequest() == NO_REQUEST){
+			schedule.setIdle(vehicleNum);
+		}
+		else{
+			schedule.setBusy(vehicleNum, nextTripEventTime(test, vehicle, time));
+		}
+	}
+
+	//Every idle vehicle searches on every tick, but a busy vehicle is only stepped when its next pickup or drop-off falls due:
+	//in between, stepping it would change nothing.
+	template<class Routing>
+	inline void runTicks(TestContext& test, std::vector<RequestId>& candidates, CandidateBatch& batch){
+		FleetSchedule schedule(test.vehicles.size());
+		std::vector<int> vehiclesDue;
+		for (unsigned i = 1; i <= test.timesToRun; i++){
+			schedule.getVehiclesDue(i, vehiclesDue);
+			for (int vehicleNum : vehiclesDue){
+				Vehicle* vehicle = test.vehicles[vehicleNum];
+				stepVehicle<Routing>(test, vehicle, i, candidates, batch);
+				rescheduleVehicle(schedule, test, vehicleNum, i);
+			}
+		}
+	}
+
+	//Batch dispatch: the vehicles left idle on a tick bid at once for every open request within their largest search radius,
+	//and the matches with the highest total score above the minimum score are made. Unlike greedy dispatch, who gets a
+	//request does not depend on the order of the fleet.
+	template<class Routing>
+	inline void assignRequests(TestContext& test, std::vector<int>& idleVehicles, int time, int searchRing, std::vector<RequestId>& candidates, CandidateBatch& batch, BatchAssignment& assignment){
+		if (idleVehicles.empty() || searchRing < 0){
+			return;
+		}
+		std::vector<ScoredCandidate> edges;
+		std::unordered_map<RequestId, int> requestNumbers;
+		assignment.clear();
+		for (int vehicleNum : idleVehicles){
+			Vehicle* vehicle = test.vehicles[vehicleNum];
+			assignment.addBidder();
+			candidates.clear();
+			test.manager->getRequestsInRing(vehicle->getCurrentLocation(), 0, searchRing, candidates);
+			if (candidates.empty()){
+				continue;
+			}
+			scoreVehicleCandidates<Routing>(vehicle, candidates, batch, test.manager, time, test.timeRadius, test.weightOfDistanceOfTrip, test.maxRideRequests);
+			for (size_t i = 0; i < batch.size(); i++){
+				if (batch.score[i] > test.minimumScore){
+					int requestNum = requestNumbers.insert(std::make_pair(candidates[i], (int)requestNumbers.size())).first->second;
+					assignment.addEdge(requestNum, batch.score[i] - test.minimumScore);
+					ScoredCandidate edge = { candidates[i], batch.pickupDistance[i], batch.rideDistance[i], batch.requestsAtDestination[i] };
+					edges.push_back(edge);
+				}
+			}
+		}
+		//Scores are a few hundred at most, so the total is within a tenth of a point per vehicle of the best possible.
+		assignment.solve(0.1f);
+		for (size_t i = 0; i < idleVehicles.size(); i++){
+			int edge = assignment.getAssignedEdge(i);
+			if (edge != -1){
+				recordRequestScore(test.manager->getRideRequests(), edges[edge]);
+				matchRequest(test.manager, test.vehicles[idleVehicles[i]], edges[edge].request, time);
+			}
+		}
+	}
+
+	//Ticks with batch dispatch: every vehicle due is moved along first, then the idle ones are matched together.
+	template<class Routing>
+	inline void runBatchTicks(TestContext& test, std::vector<RequestId>& candidates, CandidateBatch& batch){
+		FleetSchedule schedule(test.vehicles.size());
+		BatchAssignment assignment;
+		std::vector<int> vehiclesDue;
+		std::vector<int> idleVehicles;
+		int searchRing = getSearchRing(test);
+		for (unsigned i = 1; i <= test.timesToRun; i++){
+			schedule.getVehiclesDue(i, vehiclesDue);
+			idleVehicles.clear();
+			for (int vehicleNum : vehiclesDue){
+				advanceVehicle(test, test.vehicles[vehicleNum], i);
+				if (test.vehicles[vehicleNum]->getTopRequest() == NO_REQUEST){
+					idleVehicles.push_back(vehicleNum);
+				}
+			}
+			assignRequests<Routing>(test, idleVehicles, i, searchRing, candidates, batch, assignment);
+			for (int vehicleNum : vehiclesDue){
+				Vehicle* vehicle = test.vehicles[vehicleNum];
+				recordVehicleState(test, vehicle, vehicle->getCurrentLocation(), i);
+				rescheduleVehicle(schedule, test, vehicleNum, i);
+			}
+		}
+	}
+
+	//Parallel dispatch: every idle vehicle picks its greedy request at the same time, against the open requests as they stood
+	//when the round began. The picks are then committed one by one in proposalComesFirst order. A vehicle beaten to its request
+	//picks again in the next round from what is left, until every idle vehicle is matched or has nothing left to pick.
+	template<class Routing>
+	inline void matchInParallel(TestContext& test, std::vector<int>& idleVehicles, int time, ScoringWorkers& workers, std::vector<RequestProposal>& proposals){
+		while (!idleVehicles.empty()){
+			proposals.resize(idleVehicles.size());
+			workers.forEach(idleVehicles.size(), [&](size_t i, std::vector<RequestId>& candidates, CandidateBatch& batch){
+				RequestProposal& proposal = proposals[i];
+				proposal.vehicle = idleVehicles[i];
+				Vehicle* vehicle = test.vehicles[proposal.vehicle];
+				if (!proposeRequest<Routing>(test, vehicle, vehicle->getCurrentLocation(), time, candidates, batch, proposal.candidate, proposal.score)){
+					proposal.candidate.request = NO_REQUEST;
+				}
+			});
+			proposals.erase(std::remove_if(proposals.begin(), proposals.end(), [](const RequestProposal& proposal){ return proposal.candidate.request == NO_REQUEST; }), proposals.end());
+			std::sort(proposals.begin(), proposals.end(), proposalComesFirst);
+			idleVehicles.clear();
+			for (RequestProposal& proposal : proposals){
+				if (test.manager->getRideRequests().getMatchedToVehicle(proposal.candidate.request)){
+					idleVehicles.push_back(proposal.vehicle);
+				}
+				else{
+					recordRequestScore(test.manager->getRideRequests(), proposal.candidate);
+					matchRequest(test.manager, test.vehicles[proposal.vehicle], proposal.candidate.request, time);
+				}
+			}
+			std::sort(idleVehicles.begin(), idleVehicles.end());
+		}
+	}
+
+	//Ticks with parallel dispatch: every vehicle due is moved along first, then the idle ones are matched together.
+	template<class Routing>
+	inline void runParallelTicks(TestContext& test){
+		FleetSchedule schedule(test.vehicles.size());
+		ScoringWorkers workers(test.scoringThreads);
+		std::vector<int> vehiclesDue;
+		std::vector<int> idleVehicles;
+		std::vector<RequestProposal> proposals;
+		for (unsigned i = 1; i <= test.timesToRun; i++){
+			schedule.getVehiclesDue(i, vehiclesDue);
+			idleVehicles.clear();
+			for (int vehicleNum : vehiclesDue){
+				advanceVehicle(test, test.vehicles[vehicleNum], i);
+				if (test.vehicles[vehicleNum]->getTopRequest() == NO_REQUEST){
+					idleVehicles.push_back(vehicleNum);
+				}
+			}
+			matchInParallel<Routing>(test, idleVehicles, i, workers, proposals);
+			for (int vehicleNum : vehiclesDue){
+				Vehicle* vehicle = test.vehicles[vehicleNum];
+				recordVehicleState(test, vehicle, vehicle->getCurrentLocation(), i);
+				rescheduleVehicle(schedule, test, vehicleNum, i);
+			}
+		}
+	}
+
+	//Greedy dispatch on a tiled map. Every vehicle due is moved along first. Then the idle vehicles are handed to the tile of
+	//the section they stand in, and the tiles of each color search side by side, each on its own worker, its vehicles in fleet
+	//order. A vehicle that has moved changes tiles on the next tick. Searches near a tile's edge reach into the tiles
+	//around it, which belong to other colors and are never searched at the same time. The order tiles are searched in does
+	//not depend on the thread count, so neither do the results, but vehicles pick in a different order than in the tick loop.
+	template<class Routing>
+	inline void runTiledTicks(TestContext& test){
+		FleetSchedule schedule(test.vehicles.size());
+		ScoringWorkers workers(test.scoringThreads);
+		TileGrid tiles(test.manager->getGridRows(), test.manager->getGridColumns(), getSearchRing(test));
+		std::vector<int> vehiclesDue;
+		//Idle vehicles by tile, then by their place in the fleet.
+		std::vector<std::pair<int, int>> idleVehicles;
+		std::vector<size_t> tileStarts;
+		for (unsigned i = 1; i <= test.timesToRun; i++){
+			schedule.getVehiclesDue(i, vehiclesDue);
+			idleVehicles.clear();
+			for (int vehicleNum : vehiclesDue){
+				Vehicle* vehicle = test.vehicles[vehicleNum];
+				advanceVehicle(test, vehicle, i);
+				if (vehicle->getTopRequest() == NO_REQUEST){
+					idleVehicles.push_back(std::make_pair(tiles.getTile(test.manager->getSection(vehicle->getCurrentLocation())), vehicleNum));
+				}
+			}
+			std::sort(idleVehicles.begin(), idleVehicles.end());
+			size_t colorStart = 0;
+			while (colorStart < idleVehicles.size()){
+				int color = tiles.getColor(idleVehicles[colorStart].first);
+				tileStarts.clear();
+				size_t next = colorStart;
+				for (; next < idleVehicles.size() && tiles.getColor(idleVehicles[next].first) == color; next++){
+					if (next == colorStart || idleVehicles[next].first != idleVehicles[next - 1].first){
+						tileStarts.push_back(next);
+					}
+				}
+				tileStarts.push_back(next);
+				workers.forEach(tileStarts.size() - 1, [&](size_t tile, std::vector<RequestId>& candidates, CandidateBatch& batch){
+					for (size_t j = tileStarts[tile]; j < tileStarts[tile + 1]; j++){
+						Vehicle* vehicle = test.vehicles[idleVehicles[j].second];
+						searchForRequest<Routing>(test, vehicle, vehicle->getCurrentLocation(), i, candidates, batch);
+					}
+				});
+				colorStart = next;
+			}
+			for (int vehicleNum : vehiclesDue){
+				Vehicle* vehicle = test.vehicles[vehicleNum];
+				recordVehicleState(test, vehicle, vehicle->getCurrentLocation(), i);
+				rescheduleVehicle(schedule, test, vehicleNum, i);
+			}
+		}
+	}
+
+	//Steps a vehicle only on ticks where it can change: a pickup or drop-off falls due, or, while it is idle, a request comes
+	//within reach. Vehicles due on the same tick are stepped in fleet order, so the results are the same as the tick loop's.
+	template<class Routing>
+	inline void runEvents(TestContext& test, std::vector<RequestId>& candidates, CandidateBatch& batch){
+		std::vector<Vehicle*>& fleet = test.vehicles;
+		std::vector<int> lastStep(fleet.size(), 0);
+		std::vector<bool> idle(fleet.size(), false);
+		int searchRing = getSearchRing(test);
+		int lastTime = test.timesToRun;
+		EventQueue events;
+		for (size_t i = 0; i < fleet.size(); i++){
+			events.push(1, i);
+		}
+		while (!events.empty() && events.top().time <= lastTime){
+			VehicleEvent event = events.pop();
+			//A vehicle can be queued more than once for a tick.
+			if (lastStep[event.vehicle] == event.time){
+				continue;
+			}
+			lastStep[event.vehicle] = event.time;
+			Vehicle* vehicle = fleet[event.vehicle];
+			RideRequestStore& rideRequests = test.manager->getRideRequests();
+			RequestId request = vehicle->getTopRequest();
+			int requestTime = request != NO_REQUEST ? rideRequests.getRequestTime(request) : 0;
+			stepVehicle<Routing>(test, vehicle, event.time, candidates, batch);
+			if (request != NO_REQUEST && rideRequests.getRequestTime(request) != requestTime){
+				//A late pickup moved its request in time, which changes the demand counts every idle vehicle scores with.
+				for (size_t i = 0; i < fleet.size(); i++){
+					if (idle[i]){
+						events.push((int)i > event.vehicle ? event.time : event.time + 1, i);
+					}
+				}
+			}
+			idle[event.vehicle] = vehicle->getTopRequest() == NO_REQUEST;
+			int next = nextEventTime<Routing>(test, vehicle, event.time, searchRing, candidates, batch);
+			if (next != -1){
+				events.push(next, event.vehicle);
+			}
+		}
+	}
+
+	//Reads and writes nothing but its own test's context, so tests can run side by side.
+	template<class Routing>
+	inline bool runTestWithRouting(TestContext& test, int testNum){
+		std::cout << "Test " << std::to_string(testNum + 1) << " of " + std::to_string(tests.size()) << " started..." << std::endl;
+		const std::string& testName = test.name;
+		std::ofstream outputFile;
+		bool writeReport = !runningRanged && resultsFormat == RESULTS_TEXT;
+		if (writeReport){
+			std::string resultsFile = resultsFolder + testName + ".txt";
+			outputFile.open(resultsFile.c_str());
+			outputFile << testName << " Data:" << '\n' << '\n';
+
+			outputFile << "Testing Parameters:" << '\n' << '\n';
+			outputFile << "\tTimes to run: " << std::to_string(test.timesToRun) << '\n' << '\n';
+
+			outputFile << "\tMinimum Search Radius: " << std::to_string(test.radiusMin) << '\n';
+			outputFile << "\tSearch Radius Step: " << std::to_string(test.radiusStep) << '\n';
+			outputFile << "\tMaximum Search Radius: " << std::to_string(test.radiusMax) << '\n' << '\n';
+
+			outputFile << "\tTime Radius: " << std::to_string(test.timeRadius) << '\n' << '\n';
+
+			outputFile << "\tRide Request Score Calculations: " << '\n' << '\n';
+			outputFile << "\t\tDistance Calculated by: " << Routing::description() << '\n';
+			outputFile << "\t\tTime To Distance Ratio: 1:1" << '\n' << '\n';
+
+			outputFile << "\t\tPickup_Distance = Distance from car to pickup point (could also use time to arrive at pickup)" << '\n';
+			outputFile << "\t\tRide_Distance = Distance from pickup to the car's destination (could also use time to arrive at destination)" << '\n';
+			outputFile << "\t\tRequests_At_Destination = Requests projected to exist at the destination point + Requests scheduled near destination at arrival time" << '\n' << '\n';
+
+			outputFile << "\t\tRequests_At_Destination_Ceiling = Minimum number of requests available at destination to result in no penalty to score = " << std::to_string(test.maxRideRequests) << '\n';
+			outputFile << "\t\tRide_Distance_Weight = Coeficient used to determine relative value of the distance of the trip = " << std::to_string(test.weightOfDistanceOfTrip) << '\n' << '\n';
+
+			outputFile << "\t\tPercentageValueOfTrip = ((Ride_Distance)/(Ride_Distance + Pickup_Distance)) * 10" << '\n';
+			outputFile << "\t\tValueOfTripDistance = (Ride_Distance * Ride_Distance_Weight) * 10" << '\n';
+			outputFile << "\t\tDestinationPenalty:" << '\n';
+			outputFile << "\t\t\tIf Requests_At_Destination > Requests_At_Destination_Saturation, DestinationPenalty = 0" << '\n';
+			outputFile << "\t\t\tOtherwise, DestinationPenalty = -3 + (Requests_At_Destination * (3/Requests_At_Destination_Ceiling))" << '\n' << '\n';
+
+			outputFile << "\t\tRequest_Score = PercentageValueOfTrip + ValueOfTripLength + DestinationPenalty" << '\n' << '\n';
+		}
+		test.manager->indexRequests();
+		std::vector<RequestId> candidates;
+		CandidateBatch batch;
+		std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+		//Batch and parallel dispatch match the whole idle fleet on every tick, so they always run tick by tick.
+		if (test.dispatchMode == DISPATCH_BATCH){
+			runBatchTicks<Routing>(test, candidates, batch);
+		}
+		else if (test.dispatchMode == DISPATCH_PARALLEL){
+			runParallelTicks<Routing>(test);
+		}
+		else if (test.simulationMode == SIMULATION_EVENTS){
+			runEvents<Routing>(test, candidates, batch);
+		}
+		else if (test.simulationMode == SIMULATION_TILES){
+			runTiledTicks<Routing>(test);
+		}
+		else{
+			runTicks<Routing>(test, candidates, batch);
+		}
+
+		if (writeReport){
+			outputFile << '\n';
+			outputFile << "-------------------------------------------------------------------" << '\n';
+			outputFile << "Complete Test Results:" << '\n' << '\n';
+		}
+		int vehicleNum = 1;
+		float distanceWithPassenger = 0;
+		float distanceWithoutPassenger = 0;
+		float percentUtilization = 100;
+		for (Vehicle* vehicle : test.vehicles){
+			if (writeReport){
+				outputFile << "Vehicle: " << vehicleNum << '\n';
+				outputFile << '\t' << "Distance travelled with a passenger: " << vehicle->getDistanceWithPassenger() << '\n';
+				outputFile << '\t' << "Distance travelled without a passenger: " << vehicle->getDistanceWithoutPassenger() << '\n';
+				outputFile << '\n' << '\n';
+			}
+			distanceWithPassenger += vehicle->getDistanceWithPassenger();
+			distanceWithoutPassenger += vehicle->getDistanceWithoutPassenger();
+			vehicleNum++;
+		}
+		if (distanceWithPassenger + distanceWithoutPassenger != 0){
+			percentUtilization = (distanceWithPassenger) / (distanceWithoutPassenger + distanceWithPassenger);
+		}
+		else{
+			percentUtilization = 0;
+		}
+		//percentUtilization *= 100;
+		if (writeReport){
+			outputFile << "Fleet utilization is: " << percentUtilization << "%.";
+			outputFile << "\nTotal distance travelled with passengers: " << distanceWithoutPassenger << ".";
+			outputFile.close();
+		}
+		//std::cout << "\n\n";
+		test.percentUtilization = percentUtilization;
+		test.totalDistanceWithPassenger = distanceWithPassenger;
+		test.totalDistanceWithoutPassenger = distanceWithoutPassenger;
+		if (!runningRanged && resultsFormat == RESULTS_CSV){
+			addResultRows(test, testNum);
+		}
+		if (resultsWorkbook.isOpen()){
+			resultsWorkbook.addRow(testNum, getResultRow(test));
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+		std::cout << "Test " << std::to_string(testNum + 1) << " of " << std::to_string(tests.size()) << " Completed in " << elapsed.count() << "s." << std::endl;
+		return true;
+	}
+
+	inline std::vector<const char*> getTestTableColumnNames(){
+		return{ "test_number", "test", "times_to_run", "trip_distance_weight", "minimum_search_radius", "search_radius_step", "maximum_search_radius", "time_radius",
+			"minimum_score", "maximum_destination_requests", "routing_metric", "simulation_mode", "dispatch_mode", "fleet_size", "request_count",
+			"distance_with_passenger", "distance_without_passenger", "requests_completed", "percent_utilization" };
+	}
+
+	inline std::vector<const char*> getVehicleTableColumnNames(){
+		return{ "test_number", "test", "vehicle", "distance_with_passenger", "distance_without_passenger" };
+	}
+
+	//Adds a finished test's row to results.csv, and its vehicles' rows to vehicles.csv when those are kept. The rows are
+	//put together here, so the shared tables only hold their lock while appending them.
+	inline void addResultRows(TestContext& test, int testNum){
+		std::string name;
+		ResultsTable::appendField(name, test.name);
+		std::ostringstream row;
+		//Enough digits for every float to read back the same.
+		row << std::setprecision(9);
+		row << testNum + 1 << ',' << name << ',' << test.timesToRun << ',' << test.weightOfDistanceOfTrip << ',' << test.radiusMin << ',' << test.radiusStep << ',' << test.radiusMax;
+		row << ',' << test.timeRadius << ',' << test.minimumScore << ',' << test.maxRideRequests << ',' << routingMetricName(test.routingMetric);
+		row << ',' << simulationModeName(test.simulationMode) << ',' << dispatchModeName(test.dispatchMode) << ',' << test.vehicles.size() << ',' << test.manager->getRideRequests().size();
+		row << ',' << test.totalDistanceWithPassenger << ',' << test.totalDistanceWithoutPassenger << ',' << test.numberOfCompletedRequests << ',' << test.percentUtilization << '\n';
+		testResultsTable.addRows(row.str());
+		if (vehicleResults){
+			std::ostringstream rows;
+			rows << std::setprecision(9);
+			for (size_t i = 0; i < test.vehicles.size(); i++){
+				rows << testNum + 1 << ',' << name << ',' << i + 1 << ',' << test.vehicles[i]->getDistanceWithPassenger() << ',' << test.vehicles[i]->getDistanceWithoutPassenger() << '\n';
+			}
+			vehicleResultsTable.addRows(rows.str());
+		}
+	}
+
+	inline std::vector<const char*> getResultColumnNames(){
+		return{ "Trip Distance Weight", "Minimum Search Radius", "Maximum Search Radius", "Time Radius", "Minimum Score", "Maximum Destination Requests", "Distance Travelled with Passenger", "Distance Travelled Without Passenger", "Requests Completed", "Percent Utilization" };
+	}
+
+	//A test's row of the results matrix, with the columns that hold whole numbers cut to them.
+	inline std::vector<double> getResultRow(TestContext& test){
+		return{ test.weightOfDistanceOfTrip, (double)(int)test.radiusMin, (double)(int)test.radiusMax, (double)(int)test.timeRadius, test.minimumScore,
+			(double)test.maxRideRequests, (double)test.totalDistanceWithPassenger, (double)test.totalDistanceWithoutPassenger,
+			(double)test.numberOfCompletedRequests, test.percentUtilization };
+	}
+
+	inline void openResultsWorkbook(size_t rowCount){
+		resultsWorkbook.open(aggregateResultsFolder + excelFileName, "Results Matrix", getResultColumnNames(), rowCount);
+	}
+
+	//One shard's part of the results matrix: a tab separated row per test, named so the merge can put the rows back in order.
+	inline void outputToShardFile(){
+		std::string saveLocation = aggregateResultsFolder + shardFileName;
+		std::ofstream shardFile(saveLocation.c_str());
+		if (!shardFile.is_open()){
+			throw "Could not write the shard results file!";
+		}
+		//Enough digits for every float to read back the same.
+		shardFile << std::setprecision(9);
+		shardFile << "Test";
+		for (const char* columnName : getResultColumnNames()){
+			shardFile << '\t' << columnName;
+		}
+		shardFile << '\n';
+		for (TestContext* test : tests){
+			shardFile << test->name << '\t' << test->weightOfDistanceOfTrip << '\t' << test->radiusMin << '\t' << test->radiusMax << '\t' << test->timeRadius << '\t' << test->minimumScore;
+			shardFile << '\t' << test->maxRideRequests << '\t' << test->totalDistanceWithPassenger << '\t' << test->totalDistanceWithoutPassenger << '\t' << test->numberOfCompletedRequests << '\t' << test->percentUtilization << '\n';
+		}
+		if (shardFile.fail()){
+			throw "Could not write the shard results file!";
+		}
+	}
+
+public:
+	SimulationCore(){
+		runningRanged = false;
+		freeFinishedTests = false;
+		resultsFormat = RESULTS_TEXT;
+		vehicleResults = false;
+		currentTest = nullptr;
+		std::random_device device;
+		randomSeed = ((uint64_t)device() << 32) | device();
+		restartTestStreams();
+		resultsFolder = RESOURCE_FOLDER"Results/";
+		aggregateResultsFolder = RESOURCE_FOLDER"Aggregate Results/";
+	}
+
+	virtual ~SimulationCore(){}
+
+	//Loads every test file in directory. Each file's name, up to its first '.', names its test. The tests are added first,
+	//then their files are read side by side on a pool of threads: a file fills in only its own test, so the files can be
+	//read in any order and on any thread, and startup grows with the size of the largest file rather than with their count.
+	inline void loadTestFiles(const std::string& directory){
+		DIR *dirp;
+		struct dirent *dp;
+		if ((dirp = opendir(directory.c_str())) == NULL){
+			throw "Could not find current directory!";
+		}
+		std::vector<std::string> fileNames;
+		while ((dp = readdir(dirp)) != NULL){
+			fileNames.push_back(dp->d_name);
+		}
+		closedir(dirp);
+		//Tests are added in file name order, so the random stream a test draws from does not depend on how the directory lists its files.
+		std::sort(fileNames.begin(), fileNames.end());
+		TestScheduler loader;
+		for (const std::string& fileName : fileNames){
+			if (fileName[0] != '.' && fileName[1] != '.'){
+				std::string filePath = directory + fileName;
+				TestContext* test = addTest(fileName.substr(0, fileName.find_first_of('.')));
+				//Larger files are read first, so the last one to finish is a small one.
+				struct stat fileStatus;
+				double cost = stat(filePath.c_str(), &fileStatus) == 0 ? (double)fileStatus.st_size : 0;
+				loader.addTask([this, test, filePath](){
+					MappedFile file(filePath);
+					if (isScenarioFile(file)){
+						readScenarioTest(*test, file);
+					}
+					else{
+						readTestFile(*test, file, false);
+					}
+				}, cost);
+			}
+		}
+		loader.runAll();
+	}
+
+	void initializeSimulatorWithParams(const std::string& customTestName, unsigned customTimesToRun, float customTripWeight, float customRadiusMin, float customRadiusStep, float customRadiusMax,
+		float customTimeRadius, float customMinimumScore, unsigned customMaximumRideRequests, unsigned customFleetSize,
+		unsigned customRideCount, float customMaxLat, float customMaxLong, float customSectionSize, bool rangedTest = false){
+		initialize(customTestName, customTimesToRun, customTripWeight, customRadiusMin, customRadiusStep, customRadiusMax, customTimeRadius, customMinimumScore,
+			customMaximumRideRequests, customFleetSize, customRideCount, customMaxLat, customMaxLong, customSectionSize, rangedTest);
+	}
+
+	inline void setRoutingMetric(const std::string& testName, ROUTING_METRIC metric){
+		getTest(testName)->routingMetric = metric;
+	}
+
+	inline void setSimulationMode(const std::string& testName, SIMULATION_MODE mode){
+		getTest(testName)->simulationMode = mode;
+	}
+
+	inline void setDispatchMode(const std::string& testName, DISPATCH_MODE mode){
+		getTest(testName)->dispatchMode = mode;
+	}
+
+	inline void setScoringThreads(const std::string& testName, unsigned threadCount){
+		getTest(testName)->scoringThreads = threadCount;
+	}
+
+	inline void runTests(){
+		TestScheduler scheduler;
+		for (size_t testNum = 0; testNum < tests.size(); testNum++){
+			TestContext* test = tests[testNum];
+			//Every tick scores each vehicle against nearby requests, so a test's running time grows with all three.
+			size_t fleetSize = test->scenario ? test->scenario->vehicleCount : test->vehicles.size();
+			size_t requestCount = test->scenario ? test->scenario->requestCount : test->manager->getRideRequests().size();
+			double cost = (double)test->timesToRun * fleetSize * (requestCount + 1);
+			scheduler.addTask([this, testNum](){ runTest(testNum); }, cost);
+		}
+		if (!runningRanged && resultsFormat == RESULTS_CSV){
+			testResultsTable.open(resultsFolder + "results.csv", getTestTableColumnNames());
+			if (vehicleResults){
+				vehicleResultsTable.open(resultsFolder + "vehicles.csv", getVehicleTableColumnNames());
+			}
+		}
+		if (runningRanged && shardFileName.empty()){
+			openResultsWorkbook(tests.size());
+		}
+		std::cout << std::endl << std::endl;
+		scheduler.runAll();
+		testResultsTable.close();
+		vehicleResultsTable.close();
+		resultsWorkbook.close();
+		//A shard writes its file even when it drew no combinations, so the merge finds every shard.
+		if (!shardFileName.empty()){
+			outputToShardFile();
+		}
+	}
+	inline const std::vector<std::string>& getTestNames(){
+		return testNames;
+	}
+
+	inline int getTimesToRun(const std::string& testName){
+		return getTest(testName)->timesToRun;
+	}
+
+	//Frees every test's request manager, requests and vehicles.
+	inline void freeMemory(){
+		for (TestContext* test : tests){
+			releaseTestState(*test);
+			delete test;
+		}
+		tests.clear();
+		testsByName.clear();
+		testNames.clear();
+		currentTest = nullptr;
+	}
+
+	inline std::pair<int, int> getMaxCoords(const std::string& testName){
+		return getTest(testName)->manager->getMaxCoords();
+	}
+
+	inline int getSectionRadius(const std::string& testName){
+		return getTest(testName)->manager->getSectionRadius();
+	}
+
+	inline void setExcelFileName(const std::string& excelFileName){
+		this->excelFileName = excelFileName;
+	}
+
+	//Makes a ranged run write its results to this file in the aggregate results folder, for mergeShardFiles to pick up.
+	inline void setShardFileName(const std::string& shardFileName){
+		this->shardFileName = shardFileName;
+	}
+
+	inline void setFreeFinishedTests(bool freeFinishedTests){
+		this->freeFinishedTests = freeFinishedTests;
+	}
+
+	//Only tests added afterwards draw from the new seed.
+	inline void setRandomSeed(uint64_t randomSeed){
+		this->randomSeed = randomSeed;
+		restartTestStreams();
+	}
+
+	inline uint64_t getRandomSeed(){
+		return randomSeed;
+	}
+
+	inline void setScenarioFile(const std::string& scenarioFile){
+		this->scenarioFile = scenarioFile;
+	}
+
+	//Writes a test's vehicles and requests, so another process can run the same scenario. A file named *.xml is written in
+	//the test file format, anything else as a binary scenario file.
+	inline void writeScenario(const std::string& testName, const std::string& filePath){
+		TestContext* test = getTest(testName);
+		if (filePath.size() < 4 || filePath.compare(filePath.size() - 4, 4, ".xml") != 0){
+			writeScenarioBinary(*test, filePath);
+			return;
+		}
+		std::ofstream scenario(filePath.c_str());
+		if (!scenario.is_open()){
+			throw "Could not write the scenario file!";
+		}
+		scenario << "<Parameters TimesToRun=\"" << test->timesToRun << "\">" << '\n';
+		scenario << "\t<RequestManager minLat=\"" << test->manager->getMinCoords().first << "\" minLong=\"" << test->manager->getMinCoords().second;
+		scenario << "\" maxLat=\"" << test->manager->getMaxCoords().first << "\" maxLong=\"" << test->manager->getMaxCoords().second;
+		scenario << "\" sectionSize=\"" << test->manager->getSectionRadius() << "\"></RequestManager>" << '\n';
+		scenario << "\t<Requests>" << '\n';
+		RideRequestStore& rideRequests = test->manager->getRideRequests();
+		for (RequestId request = 0; request < (RequestId)rideRequests.size(); request++){
+			scenario << "\t\t<Request><Location lat=\"" << rideRequests.getLocation(request).first << "\" long=\"" << rideRequests.getLocation(request).second << "\"></Location>";
+			scenario << "<Destination lat=\"" << rideRequests.getDestination(request).first << "\" long=\"" << rideRequests.getDestination(request).second << "\"></Destination>";
+			scenario << "<RequestTime>" << rideRequests.getRequestTime(request) << "</RequestTime></Request>" << '\n';
+		}
+		scenario << "\t</Requests>" << '\n';
+		scenario << "\t<Vehicles>" << '\n';
+		for (Vehicle* vehicle : test->vehicles){
+			scenario << "\t\t<Vehicle><Location lat=\"" << vehicle->getCurrentLocation().first << "\" long=\"" << vehicle->getCurrentLocation().second << "\"></Location></Vehicle>" << '\n';
+		}
+		scenario << "\t</Vehicles>" << '\n';
+		scenario << "</Parameters>" << '\n';
+		if (scenario.fail()){
+			throw "Could not write the scenario file!";
+		}
+	}
+
+	//Writes a test that has not run yet as a binary scenario file. Unlike the test file format, the file keeps every one of
+	//the test's parameters, so it also runs as a test file.
+	inline void writeScenarioBinary(TestContext& test, const std::string& filePath){
+		ScenarioFileHeader header = makeScenarioFileHeader();
+		header.minLat = test.manager->getMinCoords().first;
+		header.minLong = test.manager->getMinCoords().second;
+		header.maxLat = test.manager->getMaxCoords().first;
+		header.maxLong = test.manager->getMaxCoords().second;
+		header.sectionSize = test.manager->getSectionRadius();
+		header.weightOfDistanceOfTrip = test.weightOfDistanceOfTrip;
+		header.timesToRun = test.timesToRun;
+		header.radiusMin = test.radiusMin;
+		header.radiusStep = test.radiusStep;
+		header.radiusMax = test.radiusMax;
+		header.timeRadius = test.timeRadius;
+		header.minimumScore = test.minimumScore;
+		header.maxRideRequests = test.maxRideRequests;
+		header.routingMetric = test.routingMetric;
+		header.simulationMode = test.simulationMode;
+		header.dispatchMode = test.dispatchMode;
+		header.scoringThreads = test.scoringThreads;
+		std::vector<ScenarioRequest> requests;
+		std::vector<ScenarioVehicle> vehicles;
+		captureRecords(test, requests, vehicles);
+		header.requestCount = requests.size();
+		header.vehicleCount = vehicles.size();
+		writeScenarioFile(filePath, header, requests.data(), vehicles.data());
+	}
+
+	//Builds the spreadsheet of a sharded ranged sweep from the files its shards wrote. Rows come out in the order
+	//of the numbers the sweep gave its tests, as if the whole sweep had run in this process.
+	inline void mergeShardFiles(const std::vector<std::string>& shardFileNames){
+		std::vector<std::pair<int, TestContext*>> rows;
+		for (const std::string& fileName : shardFileNames){
+			std::string filePath = aggregateResultsFolder + fileName;
+			std::ifstream shardFile(filePath.c_str());
+			if (!shardFile.is_open()){
+				throw "Missing a shard results file!";
+			}
+			std::string line;
+			std::getline(shardFile, line);
+			while (std::getline(shardFile, line)){
+				if (line.empty()){
+					continue;
+				}
+				std::stringstream fields(line);
+				std::string name, field;
+				std::getline(fields, name, '\t');
+				TestContext* test = new TestContext(name);
+				std::vector<std::string> values;
+				while (std::getline(fields, field, '\t')){
+					values.push_back(field);
+				}
+				if (values.size() != getResultColumnNames().size() || name.find_last_of('_') == std::string::npos){
+					delete test;
+					throw "Malformed shard results file!";
+				}
+				test->weightOfDistanceOfTrip = std::stof(values[0]);
+				test->radiusMin = std::stof(values[1]);
+				test->radiusMax = std::stof(values[2]);
+				test->timeRadius = std::stof(values[3]);
+				test->minimumScore = std::stof(values[4]);
+				test->maxRideRequests = std::stoi(values[5]);
+				test->totalDistanceWithPassenger = std::stoi(values[6]);
+				test->totalDistanceWithoutPassenger = std::stoi(values[7]);
+				test->numberOfCompletedRequests = std::stoi(values[8]);
+				test->percentUtilization = std::stof(values[9]);
+				rows.push_back(std::make_pair(std::stoi(name.substr(name.find_last_of('_') + 1)), test));
+			}
+		}
+		std::sort(rows.begin(), rows.end(), [](const std::pair<int, TestContext*>& a, const std::pair<int, TestContext*>& b){ return a.first < b.first; });
+		for (std::pair<int, TestContext*>& row : rows){
+			tests.push_back(row.second);
+			testsByName[row.second->name] = row.second;
+			testNames.push_back(row.second->name);
+		}
+		openResultsWorkbook(rows.size());
+		for (size_t i = 0; i < rows.size(); i++){
+			resultsWorkbook.addRow(i, getResultRow(*rows[i].second));
+		}
+		resultsWorkbook.close();
+	}
+
+	inline void setResultsFolder(const std::string& resultsFolder){
+		this->resultsFolder = resultsFolder;
+	}
+
+	inline void setResultsFormat(RESULTS_FORMAT format){
+		resultsFormat = format;
+	}
+
+	inline void setVehicleResults(bool vehicleResults){
+		this->vehicleResults = vehicleResults;
+	}
+
+	inline void setAggregateResultsFolder(const std::string& aggregateResultsFolder){
+		this->aggregateResultsFolder = aggregateResultsFolder;
+	}
+
+	inline const std::string& getAggregateResultsFolder(){
+		return aggregateResultsFolder;
+	}
+
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef _TEST_CONTEXT_H
+#define _TEST_CONTEXT_H
+#include <string>
+#include <vector>
+#include <memory>
+#include "enumHelper.h"
+#include "Scenario.h"
+#include "EntityPool.h"
+#include "RandomStream.h"
+#include "Vehicle.h"
+
+class RequestManager;
+
+//Everything one test reads and writes while it runs. Each test owns its context, so tests running at the same time share no state.
+struct TestContext{
+	std::string name;
+
+	float weightOfDistanceOfTrip;
+	unsigned timesToRun;
+	float radiusMin;
+	float radiusStep;
+	float radiusMax;
+	float timeRadius;
+	float minimumScore;
+	int maxRideRequests;
+	ROUTING_METRIC routingMetric;
+	SIMULATION_MODE simulationMode;
+	DISPATCH_MODE dispatchMode;
+	//Threads parallel dispatch and tiled simulation run on, 0 for one per hardware thread.
+	unsigned scoringThreads;
+
+	//Set for the tests of a ranged sweep. Their manager and vehicles are built from it when the test starts.
+	std::shared_ptr<const Scenario> scenario;
+	RequestManager* manager;
+	//The fleet, in order. Its vehicles live in the pool, which frees them all at once.
+	std::vector<Vehicle*> vehicles;
+	EntityPool<Vehicle> vehiclePool;
+	//Draws the test's random requests and vehicles.
+	RandomStream random;
+
+	//Filled in when the test finishes.
+	float percentUtilization;
+	int totalDistanceWithPassenger;
+	int totalDistanceWithoutPassenger;
+	int numberOfCompletedRequests;
+
+	//Parameters start at the defaults used for test files.
+	TestContext(const std::string& name) : name(name){
+		weightOfDistanceOfTrip = 0.002;
+		timesToRun = 10;
+		radiusMin = 5;
+		radiusStep = 5;
+		radiusMax = 15;
+		timeRadius = 5;
+		minimumScore = 5;
+		maxRideRequests = 30;
+		routingMetric = ROUTING_EUCLIDEAN;
+		simulationMode = SIMULATION_TICKS;
+		dispatchMode = DISPATCH_GREEDY;
+		scoringThreads = 0;
+		manager = nullptr;
+		percentUtilization = 0;
+		totalDistanceWithPassenger = 0;
+		totalDistanceWithoutPassenger = 0;
+		numberOfCompletedRequests = 0;
+	}
+};
+
+#endif
@@ -0,0 +1,114 @@
+#include "TestScheduler.h"
+#include <algorithm>
+
+TestScheduler::TestScheduler(unsigned threadCount)
+{
+	if (threadCount == 0){
+		threadCount = std::thread::hardware_concurrency();
+	}
+	if (threadCount == 0){
+		threadCount = 1;
+	}
+	batchNumber = 0;
+	tasksRemaining = 0;
+	stopping = false;
+	for (unsigned i = 0; i < threadCount; i++){
+		queues.push_back(new WorkerQueue);
+	}
+	for (unsigned i = 0; i < threadCount; i++){
+		workers.push_back(std::thread(&TestScheduler::workerLoop, this, i));
+	}
+}
+
+TestScheduler::~TestScheduler()
+{
+	{
+		std::lock_guard<std::mutex> guard(stateLock);
+		stopping = true;
+	}
+	batchStarted.notify_all();
+	for (std::thread& worker : workers){
+		worker.join();
+	}
+	for (WorkerQueue* queue : queues){
+		delete queue;
+	}
+}
+
+void TestScheduler::addTask(std::function<void()> task, double cost){
+	ScheduledTask scheduled;
+	scheduled.task = task;
+	scheduled.cost = cost;
+	pendingTasks.push_back(scheduled);
+}
+
+void TestScheduler::runAll(){
+	if (pendingTasks.empty()){
+		return;
+	}
+	std::stable_sort(pendingTasks.begin(), pendingTasks.end(), [](const ScheduledTask& a, const ScheduledTask& b){ return a.cost > b.cost; });
+	std::unique_lock<std::mutex> state(stateLock);
+	//Counted before any task is queued: a worker still draining the queues may pick a task up as soon as it is pushed.
+	tasksRemaining = pendingTasks.size();
+	firstError = nullptr;
+	//Dealt out in turn, so every queue starts with one of the largest tests and stays sorted largest first.
+	for (size_t i = 0; i < pendingTasks.size(); i++){
+		WorkerQueue* queue = queues[i % queues.size()];
+		std::lock_guard<std::mutex> guard(queue->lock);
+		queue->tasks.push_back(pendingTasks[i].task);
+	}
+	pendingTasks.clear();
+	batchNumber++;
+	batchStarted.notify_all();
+	batchFinished.wait(state, [this](){ return tasksRemaining == 0; });
+	if (firstError){
+		std::exception_ptr error = firstError;
+		firstError = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+//Takes the front of the worker's own queue, or else the front of the first other queue with work left.
+bool TestScheduler::takeTask(size_t workerIndex, std::function<void()>& task){
+	for (size_t i = 0; i < queues.size(); i++){
+		WorkerQueue* queue = queues[(workerIndex + i) % queues.size()];
+		std::lock_guard<std::mutex> guard(queue->lock);
+		if (!queue->tasks.empty()){
+			task = std::move(queue->tasks.front());
+			queue->tasks.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+void TestScheduler::workerLoop(size_t workerIndex){
+	unsigned batchesSeen = 0;
+	while (true){
+		{
+			std::unique_lock<std::mutex> state(stateLock);
+			batchStarted.wait(state, [this, batchesSeen](){ return stopping || batchNumber != batchesSeen; });
+			if (stopping){
+				return;
+			}
+			batchesSeen = batchNumber;
+		}
+		std::function<void()> task;
+		while (takeTask(workerIndex, task)){
+			std::exception_ptr error;
+			try{
+				task();
+			}
+			catch (...){
+				error = std::current_exception();
+			}
+			std::lock_guard<std::mutex> guard(stateLock);
+			if (error && !firstError){
+				firstError = error;
+			}
+			if (--tasksRemaining == 0){
+				batchFinished.notify_all();
+			}
+		}
+	}
+}
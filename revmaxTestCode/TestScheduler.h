@@ -0,0 +1,56 @@
+#ifndef _TEST_SCHEDULER_H
+#define _TEST_SCHEDULER_H
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+//Fixed pool of worker threads that runs a batch of tests. Each worker has its own queue and steals from the others once it
+//runs dry. Tests are handed out largest first, so the long ones start early instead of keeping cores busy at the end.
+class TestScheduler
+{
+protected:
+	struct ScheduledTask{
+		std::function<void()> task;
+		double cost;
+	};
+
+	struct WorkerQueue{
+		std::mutex lock;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	std::vector<ScheduledTask> pendingTasks;
+	std::vector<WorkerQueue*> queues;
+	std::vector<std::thread> workers;
+
+	std::mutex stateLock;
+	//Wakes the workers when a batch starts or the scheduler shuts down.
+	std::condition_variable batchStarted;
+	//Wakes the thread waiting in runAll when the last task of the batch finishes.
+	std::condition_variable batchFinished;
+	unsigned batchNumber;
+	size_t tasksRemaining;
+	bool stopping;
+	std::exception_ptr firstError;
+
+	bool takeTask(size_t workerIndex, std::function<void()>& task);
+	void workerLoop(size_t workerIndex);
+public:
+	//A thread count of 0 uses one worker per hardware thread.
+	TestScheduler(unsigned threadCount = 0);
+	~TestScheduler();
+
+	//Cost only orders the tests: anything proportional to a test's running time will do.
+	void addTask(std::function<void()> task, double cost);
+
+	//Runs every added task and blocks until all of them have finished. The first exception a task threw is rethrown here.
+	void runAll();
+
+	size_t getThreadCount(){ return workers.size(); }
+};
+
+#endif
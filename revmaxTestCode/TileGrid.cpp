@@ -0,0 +1,18 @@
+#include "TileGrid.h"
+
+TileGrid::TileGrid(int gridRows, int gridColumns, int searchRing)
+{
+	//A search reaches searchRing sections past its own, so tiles two apart stay out of each other's reach.
+	tileSize = searchRing > 0 ? 2 * searchRing : 1;
+	tileRows = (gridRows + tileSize - 1) / tileSize;
+	tileColumns = (gridColumns + tileSize - 1) / tileSize;
+	colorRows = (tileRows + 1) / 2;
+	colorColumns = (tileColumns + 1) / 2;
+}
+
+int TileGrid::getTile(std::pair<int, int> section){
+	int tileRow = section.first / tileSize;
+	int tileColumn = section.second / tileSize;
+	int color = (tileRow % 2) * 2 + tileColumn % 2;
+	return color * colorRows * colorColumns + (tileRow / 2) * colorColumns + tileColumn / 2;
+}
@@ -0,0 +1,24 @@
+#ifndef _TILE_GRID_H
+#define _TILE_GRID_H
+#include <utility>
+
+//Splits a request grid into square tiles of sections so one test can be simulated on several threads. Every tile is at
+//least twice the search ring wide, so the sections searched from two tiles of the same color never overlap: tiles of one
+//color can search and match side by side, and each color sees the matches the colors before it made along its edges.
+//Tiles are numbered color by color, so sorting by tile also groups the tiles by color.
+class TileGrid
+{
+protected:
+	int tileSize;
+	int tileRows, tileColumns;
+	//Tiles of one color, as a grid of every other tile row and column.
+	int colorRows, colorColumns;
+public:
+	TileGrid(int gridRows, int gridColumns, int searchRing);
+
+	//Tile holding a section, given as its row and column in the request grid.
+	int getTile(std::pair<int, int> section);
+	int getColor(int tile){ return tile / (colorRows * colorColumns); }
+};
+
+#endif
@@ -1,10 +1,13 @@
 #include "Vehicle.h"
-#include "RideRequest.h"
-#include "Texture.h"
-#include "renderingMathHelper.h"
+#include "RequestManager.h"
+#include "mathHelper.h"
 
 Vehicle::Vehicle()
 {
+	distanceWithPassenger = 0;
+	distanceWithoutPassenger = 0;
+	previousTime = 0;
+	hasPassenger = false;
 }
 
 
@@ -12,15 +15,15 @@ Vehicle::~Vehicle()
 {
 }
 
-std::pair<long, long> Vehicle::getLastDestination(){
-	return requests.back()->getDestination();
+std::pair<long, long> Vehicle::getLastDestination(RideRequestStore& rideRequests){
+	return rideRequests.getDestination(requests.back());
 }
 
 std::pair<long, long> Vehicle::getCurrentLocation(){
 	return currentLocation;
 }
 
-void Vehicle::addRequest(RideRequest* request){
+void Vehicle::addRequest(RequestId request){
 	requests.push(request);
 }
 
@@ -33,21 +36,23 @@ void Vehicle::addToRoutingLog(float time, std::pair<float, float> location){
 	routingLog.push(std::make_pair(time, location));
 }
 
-void Vehicle::update(){
+void Vehicle::update(RequestManager* manager){
 	if (requests.size() != 0){
-		std::pair<float, float> rLocation = requests.front()->getLocation();
-		std::pair<float, float> rDestination = requests.front()->getDestination();
-		bool rPickedUp = requests.front()->getPickedUp();
+		RideRequestStore& rideRequests = manager->getRideRequests();
+		RequestId request = requests.front();
+		std::pair<float, float> rLocation = rideRequests.getLocation(request);
+		std::pair<float, float> rDestination = rideRequests.getDestination(request);
+		bool rPickedUp = rideRequests.getPickedUp(request);
 		if (currentLocation.first == rLocation.first && currentLocation.second == rLocation.second && !rPickedUp){
-			requests.front()->setPickedUp(true);
+			rideRequests.setPickedUp(request, true);
 		}
 		else if (currentLocation.first == rLocation.first && currentLocation.second == rLocation.second && rPickedUp){
-			distanceWithPassenger += requests.front()->getDistanceOfRequest();
+			distanceWithPassenger += rideRequests.getDistanceOfRequest(request);
 			currentLocation.first = rDestination.first;
 			currentLocation.second = rDestination.second;
 		}
 		else if (currentLocation.first != rLocation.first && currentLocation.second != rLocation.second && !rPickedUp){
-			distanceWithoutPassenger += requests.front()->getDistanceToRequest();
+			distanceWithoutPassenger += rideRequests.getDistanceToRequest(request);
 			currentLocation.first = rLocation.first;
 			currentLocation.second = rLocation.second;
 		}
@@ -58,22 +63,24 @@ void Vehicle::update(){
 	}
 }
 
-void Vehicle::update(int time){
+void Vehicle::update(int time, RequestManager* manager){
 	if (requests.size() != 0){
-		std::pair<float, float> rLocation = requests.front()->getLocation();
-		std::pair<float, float> rDestination = requests.front()->getDestination();
-		int requestTime = requests.front()->getRequestTime();
-		int dropOffTime = requests.front()->getDistanceOfRequest() + requestTime;
-		bool rPickedUp = requests.front()->getPickedUp();
+		RideRequestStore& rideRequests = manager->getRideRequests();
+		RequestId request = requests.front();
+		std::pair<float, float> rLocation = rideRequests.getLocation(request);
+		std::pair<float, float> rDestination = rideRequests.getDestination(request);
+		int requestTime = rideRequests.getRequestTime(request);
+		int dropOffTime = rideRequests.getDistanceOfRequest(request) + requestTime;
+		bool rPickedUp = rideRequests.getPickedUp(request);
 
 		if (time == requestTime && !rPickedUp){
-			requests.front()->setPickedUp(true);
+			rideRequests.setPickedUp(request, true);
 			currentLocation.first = rLocation.first;
 			currentLocation.second = rLocation.second;
-			distanceWithoutPassenger += requests.front()->getDistanceToRequest();
+			distanceWithoutPassenger += rideRequests.getDistanceToRequest(request);
 		}
 		else if (time == dropOffTime && rPickedUp){
-			distanceWithPassenger += requests.front()->getDistanceOfRequest();
+			distanceWithPassenger += rideRequests.getDistanceOfRequest(request);
 			currentLocation.first = rDestination.first;
 			currentLocation.second = rDestination.second;
 		}
@@ -84,28 +91,30 @@ void Vehicle::update(int time){
 	}
 }
 
-void Vehicle::update(int time, int timeRadius){
+void Vehicle::update(int time, int timeRadius, RequestManager* manager){
 	if (requests.size() != 0){
-		std::pair<float, float> rLocation = requests.front()->getLocation();
-		std::pair<float, float> rDestination = requests.front()->getDestination();
-		int requestTime = requests.front()->getRequestTime();
-		int matchTime = requests.front()->getTimeMatched();
-		//int dropOffTime = requests.front()->getDistanceOfRequest() + requestTime;
-		bool rPickedUp = requests.front()->getPickedUp();
-		int actualPickupTime = matchTime + requests.front()->getDistanceToRequest();
+		RideRequestStore& rideRequests = manager->getRideRequests();
+		RequestId request = requests.front();
+		std::pair<float, float> rLocation = rideRequests.getLocation(request);
+		std::pair<float, float> rDestination = rideRequests.getDestination(request);
+		int requestTime = rideRequests.getRequestTime(request);
+		int matchTime = rideRequests.getTimeMatched(request);
+		//int dropOffTime = rideRequests.getDistanceOfRequest(request) + requestTime;
+		bool rPickedUp = rideRequests.getPickedUp(request);
+		int actualPickupTime = matchTime + rideRequests.getDistanceToRequest(request);
 		if (actualPickupTime < requestTime){
 			actualPickupTime = requestTime;
 		}
-		int dropOffTime = requests.front()->getDistanceOfRequest() + actualPickupTime;
+		int dropOffTime = rideRequests.getDistanceOfRequest(request) + actualPickupTime;
 		if ((time >= requestTime && time <= requestTime + timeRadius) && (time == actualPickupTime) && !rPickedUp){
-			requests.front()->setPickedUp(true);
+			rideRequests.setPickedUp(request, true);
 			currentLocation.first = rLocation.first;
 			currentLocation.second = rLocation.second;
-			distanceWithoutPassenger += requests.front()->getDistanceToRequest();
-			requests.front()->setRequestTime(actualPickupTime);
+			distanceWithoutPassenger += rideRequests.getDistanceToRequest(request);
+			manager->setRequestTime(request, actualPickupTime);
 		}
 		else if ((time >= dropOffTime && time <= dropOffTime + timeRadius) && rPickedUp){
-			distanceWithPassenger += requests.front()->getDistanceOfRequest();
+			distanceWithPassenger += rideRequests.getDistanceOfRequest(request);
 			currentLocation.first = rDestination.first;
 			currentLocation.second = rDestination.second;
 		}
@@ -123,9 +132,9 @@ void Vehicle::popTopRequest(){
 	requests.pop();
 }
 
-RideRequest* Vehicle::getTopRequest(){
+RequestId Vehicle::getTopRequest(){
 	if (requests.size() == 0){
-		return nullptr;
+		return NO_REQUEST;
 	}
 	return requests.front();
 }
@@ -2,17 +2,17 @@
 #define _VEHICLE_H
 #include <queue>
 #include <unordered_map>
-#include "ShaderProgram.h"
 #include "Matrix.h"
+#include "RideRequestStore.h"
 
-class RideRequest;
+class RequestManager;
 class Vehicle
 {
 protected:
-	std::queue<RideRequest*> requests;
+	std::queue<RequestId> requests;
 	std::pair<long, long> currentLocation;
 
-	std::pair<long, long> getLastDestination();
+	std::pair<long, long> getLastDestination(RideRequestStore& rideRequests);
 
 
 	long distanceWithPassenger;
@@ -33,18 +33,19 @@ public:
 	void freeMemory();
 	std::pair<long, long> getCurrentLocation();
 
-	void addRequest(RideRequest* request);
+	void addRequest(RequestId request);
 
 	void setLocation(long latitude, long longitude);
 
 	void setStartingLocation(long latitude, long longitude);
 
 	//Update assuming that vehicles always take one hour to arrive at 
-	void update();
+	//The manager holds the requests the vehicle carries.
+	void update(RequestManager* manager);
 
-	void update(int time);
+	void update(int time, RequestManager* manager);
 
-	void update(int time, int timeRadius);
+	void update(int time, int timeRadius, RequestManager* manager);
 
 	void updateForRendering(float time);
 
@@ -52,7 +53,8 @@ public:
 
 	void addToRoutingLog(float time, std::pair<float, float> location);
 
-	RideRequest* getTopRequest();
+	//NO_REQUEST when the vehicle has none.
+	RequestId getTopRequest();
 
 	long getDistanceWithPassenger();
 	long getDistanceWithoutPassenger();
@@ -0,0 +1,191 @@
+#include "XmlStream.h"
+#include <stdlib.h>
+#include <errno.h>
+#include <limits.h>
+
+//Numbers are converted in a small NUL terminated copy, as strtof and strtol need one. Anything too long for it, which
+//only padding could make, goes through a string instead.
+static const char* terminate(const XmlText& text, char* buffer, size_t bufferSize, std::string& longText){
+	size_t length = text.end - text.begin;
+	if (length < bufferSize){
+		memcpy(buffer, text.begin, length);
+		buffer[length] = '\0';
+		return buffer;
+	}
+	longText = text.toString();
+	return longText.c_str();
+}
+
+float XmlText::toFloat() const{
+	char buffer[64];
+	std::string longText;
+	const char* value = terminate(*this, buffer, sizeof(buffer), longText);
+	char* parsedEnd;
+	errno = 0;
+	float result = strtof(value, &parsedEnd);
+	if (parsedEnd == value){
+		throw "Invalid number in test file!";
+	}
+	if (errno == ERANGE){
+		throw "Number out of range in test file!";
+	}
+	return result;
+}
+
+int XmlText::toInt() const{
+	char buffer[64];
+	std::string longText;
+	const char* value = terminate(*this, buffer, sizeof(buffer), longText);
+	char* parsedEnd;
+	errno = 0;
+	long result = strtol(value, &parsedEnd, 10);
+	if (parsedEnd == value){
+		throw "Invalid number in test file!";
+	}
+	if (errno == ERANGE || result < INT_MIN || result > INT_MAX){
+		throw "Number out of range in test file!";
+	}
+	return (int)result;
+}
+
+XmlStream::XmlStream(const char* begin, const char* end) : position(begin), end(end), selfClosing(false)
+{
+	name.begin = name.end = begin;
+}
+
+void XmlStream::skipWhitespace(){
+	while (position < end && (*position == ' ' || *position == '\t' || *position == '\n' || *position == '\r')){
+		position++;
+	}
+}
+
+void XmlStream::skipPast(const char* marker){
+	size_t length = strlen(marker);
+	while ((size_t)(end - position) >= length){
+		if (memcmp(position, marker, length) == 0){
+			position += length;
+			return;
+		}
+		position++;
+	}
+	throw "Malformed test file!";
+}
+
+XmlText XmlStream::readName(){
+	XmlText text;
+	text.begin = position;
+	while (position < end && *position != ' ' && *position != '\t' && *position != '\n' && *position != '\r' &&
+		*position != '/' && *position != '>' && *position != '='){
+		position++;
+	}
+	text.end = position;
+	return text;
+}
+
+void XmlStream::readStartTag(){
+	position++;
+	name = readName();
+	if (name.empty()){
+		throw "Malformed test file!";
+	}
+	attributes.clear();
+	while (true){
+		skipWhitespace();
+		if (position >= end){
+			throw "Malformed test file!";
+		}
+		if (*position == '>'){
+			position++;
+			selfClosing = false;
+			return;
+		}
+		if (*position == '/'){
+			if (end - position < 2 || position[1] != '>'){
+				throw "Malformed test file!";
+			}
+			position += 2;
+			selfClosing = true;
+			return;
+		}
+		XmlText attributeName = readName();
+		skipWhitespace();
+		if (attributeName.empty() || position >= end || *position != '='){
+			throw "Malformed test file!";
+		}
+		position++;
+		skipWhitespace();
+		if (position >= end || (*position != '"' && *position != '\'')){
+			throw "Malformed test file!";
+		}
+		char quote = *position;
+		XmlText value;
+		value.begin = ++position;
+		while (position < end && *position != quote){
+			position++;
+		}
+		if (position >= end){
+			throw "Malformed test file!";
+		}
+		value.end = position++;
+		attributes.push_back(std::make_pair(attributeName, value));
+	}
+}
+
+bool XmlStream::nextElement(){
+	if (selfClosing){
+		selfClosing = false;
+		return false;
+	}
+	while (true){
+		//Text between elements is never needed here, so it is stepped over.
+		while (position < end && *position != '<'){
+			position++;
+		}
+		if (position >= end){
+			return false;
+		}
+		size_t left = end - position;
+		if (left >= 4 && memcmp(position, "<!--", 4) == 0){
+			skipPast("-->");
+		}
+		else if (left >= 9 && memcmp(position, "<![CDATA[", 9) == 0){
+			skipPast("]]>");
+		}
+		else if (left >= 2 && (position[1] == '?' || position[1] == '!')){
+			skipPast(">");
+		}
+		else if (left >= 2 && position[1] == '/'){
+			skipPast(">");
+			return false;
+		}
+		else{
+			readStartTag();
+			return true;
+		}
+	}
+}
+
+XmlText XmlStream::readText(){
+	XmlText text;
+	text.begin = text.end = position;
+	if (selfClosing){
+		selfClosing = false;
+		return text;
+	}
+	while (text.end < end && *text.end != '<'){
+		text.end++;
+	}
+	position = text.end;
+	skipElement();
+	return text;
+}
+
+void XmlStream::skipElement(){
+	if (selfClosing){
+		selfClosing = false;
+		return;
+	}
+	while (nextElement()){
+		skipElement();
+	}
+}
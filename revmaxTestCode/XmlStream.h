@@ -0,0 +1,67 @@
+#ifndef _XML_STREAM_H
+#define _XML_STREAM_H
+#include <string>
+#include <vector>
+#include <string.h>
+
+//A run of characters inside the text being read. It is not NUL terminated and only lives as long as that text.
+struct XmlText
+{
+	const char* begin;
+	const char* end;
+
+	inline bool operator==(const char* text) const{
+		size_t length = strlen(text);
+		return (size_t)(end - begin) == length && memcmp(begin, text, length) == 0;
+	}
+	inline bool operator!=(const char* text) const{ return !(*this == text); }
+	inline bool empty() const{ return begin == end; }
+	inline std::string toString() const{ return std::string(begin, end); }
+
+	//Convert the way std::stof and std::stoi do, leading whitespace and trailing junk included, but throw const char* errors.
+	float toFloat() const;
+	int toInt() const;
+};
+
+//Reads XML front to back one element at a time without building a tree, so memory stays flat however big the file is.
+//After nextElement finds an element, its attributes can be read, and then the element must be finished with exactly one
+//of: calling nextElement until it returns false to walk its children, readText, or skipElement.
+//Entities are not decoded, since test files hold only names and numbers.
+class XmlStream
+{
+protected:
+	const char* position;
+	const char* end;
+	XmlText name;
+	std::vector<std::pair<XmlText, XmlText> > attributes;
+	//The element just found was written <Name/>, so it has no children and no end tag to read.
+	bool selfClosing;
+
+	void skipWhitespace();
+	void skipPast(const char* marker);
+	XmlText readName();
+	void readStartTag();
+public:
+	XmlStream(const char* begin, const char* end);
+
+	//Moves to the next element in the element being walked. Returns false, after reading its end tag, once that element
+	//has no more children, or at the end of the text.
+	bool nextElement();
+	//Reads the text up to the end tag of the current element and finishes the element.
+	XmlText readText();
+	//Steps over whatever is left of the current element.
+	void skipElement();
+
+	inline bool isNamed(const char* elementName){ return name == elementName; }
+	//Returns nullptr when the current element has no attribute of that name.
+	inline const XmlText* getAttribute(const char* attributeName){
+		for (const std::pair<XmlText, XmlText>& attribute : attributes){
+			if (attribute.first == attributeName){
+				return &attribute.second;
+			}
+		}
+		return nullptr;
+	}
+};
+
+#endif
@@ -0,0 +1,96 @@
+#include "BatchAssignment.h"
+#include <vector>
+#include <random>
+#include <iostream>
+#include <cstdlib>
+#include <stdint.h>
+
+//Checks BatchAssignment against an exhaustive search on small random problems: every matching it returns must use each
+//object at most once, and its total benefit must be within epsilon per bidder of the best matching. Run by "make check".
+
+struct Edge{
+	int object;
+	float benefit;
+};
+
+//Best total benefit of matching bidders [bidder, end) to objects not yet used, each bidder taking one edge or none.
+static float bestTotal(const std::vector<std::vector<Edge>>& edges, size_t bidder, std::vector<bool>& used){
+	if (bidder == edges.size()){
+		return 0;
+	}
+	float best = bestTotal(edges, bidder + 1, used);
+	for (const Edge& edge : edges[bidder]){
+		if (!used[edge.object]){
+			used[edge.object] = true;
+			float total = edge.benefit + bestTotal(edges, bidder + 1, used);
+			used[edge.object] = false;
+			if (total > best){
+				best = total;
+			}
+		}
+	}
+	return best;
+}
+
+int main(int argc, char** argv){
+	const int instanceCount = argc > 1 ? std::atoi(argv[1]) : 20000;
+	const uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+	//What the batch dispatch mode solves with.
+	const float epsilon = 0.1f;
+	std::mt19937_64 random(seed);
+	std::uniform_int_distribution<int> count(1, 8), coin(0, 1), smallBenefit(1, 3);
+	std::uniform_real_distribution<float> benefit(0.01f, 300);
+	BatchAssignment assignment;
+	int failures = 0;
+	float worstGap = 0;
+	for (int instance = 0; instance < instanceCount; instance++){
+		int bidderCount = count(random);
+		int objectCount = count(random);
+		std::vector<std::vector<Edge>> edges(bidderCount);
+		assignment.clear();
+		for (int bidder = 0; bidder < bidderCount; bidder++){
+			assignment.addBidder();
+			for (int object = 0; object < objectCount; object++){
+				if (coin(random) == 0){
+					continue;
+				}
+				//Benefits close together make the bidding wars that epsilon has to end.
+				Edge edge = { object, coin(random) == 0 ? benefit(random) : (float)smallBenefit(random) };
+				edges[bidder].push_back(edge);
+				assignment.addEdge(edge.object, edge.benefit);
+			}
+		}
+		assignment.solve(epsilon);
+
+		std::vector<bool> used(objectCount, false);
+		float total = 0;
+		bool valid = true;
+		for (int bidder = 0; bidder < bidderCount; bidder++){
+			int edge = assignment.getAssignedEdge(bidder);
+			if (edge == -1){
+				continue;
+			}
+			int first = 0;
+			for (int earlier = 0; earlier < bidder; earlier++){
+				first += edges[earlier].size();
+			}
+			if (edge < first || edge >= first + (int)edges[bidder].size() || used[edges[bidder][edge - first].object]){
+				valid = false;
+				break;
+			}
+			used[edges[bidder][edge - first].object] = true;
+			total += edges[bidder][edge - first].benefit;
+		}
+		std::vector<bool> unused(objectCount, false);
+		float best = bestTotal(edges, 0, unused);
+		if (valid && best - total > worstGap){
+			worstGap = best - total;
+		}
+		if (!valid || total < best - epsilon * bidderCount - 0.001f){
+			failures++;
+			std::cout << "Instance " << instance << ": " << (valid ? "" : "invalid matching, ") << "total " << total << ", best " << best << std::endl;
+		}
+	}
+	std::cout << instanceCount - failures << " of " << instanceCount << " instances within " << epsilon << " per bidder of the best, worst gap " << worstGap << "." << std::endl;
+	return failures == 0 ? 0 : 1;
+}
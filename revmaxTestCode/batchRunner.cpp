@@ -0,0 +1,421 @@
+#include "SimulationCore.h"
+#include <string>
+#include <vector>
+#include <iostream>
+#include <initializer_list>
+#include <thread>
+#include <cstdlib>
+
+//Headless entry point: runs tests from XML files or from command line parameters and writes their results,
+//without creating a window. Built separately from main.cpp, see Makefile and revmaxBatchRunner.vcxproj.
+
+struct ParameterRange{
+	float bottom, top, step;
+};
+
+static void printUsage(){
+	std::cout << "Usage: revmaxBatch [--xml <folder> | --custom <name> | --ranged <name>] [options]" << std::endl << std::endl;
+	std::cout << "Modes:" << std::endl;
+	std::cout << "\t--xml <folder>\t\tRun every test file in the folder (the default mode, reading " << RESOURCE_FOLDER"XML/)" << std::endl;
+	std::cout << "\t--custom <name>\t\tRun one test built from the parameters below" << std::endl;
+	std::cout << "\t--ranged <name>\t\tRun every combination of the ranged parameters below and write <name>.xls" << std::endl << std::endl;
+	std::cout << "Sharded ranged sweeps:" << std::endl;
+	std::cout << "\t--processes <n>\t\tSplit the sweep into n shards, run each in its own process and merge their results" << std::endl;
+	std::cout << "\t--shard <k>/<n>\t\tRun shard k (from 0) of n and write <name>.shard<k>.txt to the aggregate folder" << std::endl;
+	std::cout << "\t--merge <n>\t\tWrite <name>.xls from the n shard files in the aggregate folder" << std::endl;
+	std::cout << "\t--scenario <file>\tTake the vehicles and requests from a test file or binary scenario file instead of drawing them" << std::endl;
+	std::cout << "\t--save-scenario <file>\tWrite the vehicles and requests drawn for the first test to a file, binary unless named *.xml" << std::endl << std::endl;
+	std::cout << "Binary scenarios:" << std::endl;
+	std::cout << "\t--export <folder>\tWrite each test file's test to <folder><name>.scenario instead of running it" << std::endl << std::endl;
+	std::cout << "Random draws:" << std::endl;
+	std::cout << "\t--seed <n>\t\tSeed for the random vehicles and requests; the same seed draws the same tests (a new seed each run)" << std::endl << std::endl;
+	std::cout << "Output:" << std::endl;
+	std::cout << "\t--results <folder>\tFolder for the results of tests that are not ranged" << std::endl;
+	std::cout << "\t--results-format <format>\tCsv for one row per test in results.csv, or Text for a report per test (Csv)" << std::endl;
+	std::cout << "\t--vehicle-results <0|1>\tWith Csv, also write one row per vehicle to vehicles.csv (0)" << std::endl;
+	std::cout << "\t--aggregate <folder>\tFolder for the ranged results spreadsheet" << std::endl << std::endl;
+	std::cout << "Parameters:" << std::endl;
+	std::cout << "\t--times-to-run <n>\t\t(10)" << std::endl;
+	std::cout << "\t--fleet-size <n>\t\t(10)" << std::endl;
+	std::cout << "\t--request-count <n>\t\t(10)" << std::endl;
+	std::cout << "\t--max-lat <n>\t\t\t(20)" << std::endl;
+	std::cout << "\t--max-long <n>\t\t\t(20)" << std::endl;
+	std::cout << "\t--section-size <n>\t\t(5)" << std::endl;
+	std::cout << "\t--radius-steps <n>\t\tNumber of radius steps past the minimum radius (2)" << std::endl;
+	std::cout << "\t--routing <metric>\t\tEuclidean, Manhattan or GridGraph (Euclidean)" << std::endl;
+	std::cout << "\t--simulation <mode>\t\tTicks, Events or Tiles, also overriding test files (Ticks)" << std::endl;
+	std::cout << "\t--dispatch <mode>\t\tGreedy, Batch or Parallel, also overriding test files (Greedy)" << std::endl;
+	std::cout << "\t--scoring-threads <n>\t\tThreads for Parallel dispatch and Tiles, 0 for one per core, also overriding test files (0)" << std::endl << std::endl;
+	std::cout << "Ranged parameters, given as <value> or, with --ranged, <bottom>:<top>[:<step>]:" << std::endl;
+	std::cout << "\t--trip-weight\t\t\t(0.002, step 0.001)" << std::endl;
+	std::cout << "\t--radius-min\t\t\t(5, step 1)" << std::endl;
+	std::cout << "\t--radius-step\t\t\t(5, step 1)" << std::endl;
+	std::cout << "\t--time-radius\t\t\t(5, step 1)" << std::endl;
+	std::cout << "\t--minimum-score\t\t\t(30, step 5)" << std::endl;
+	std::cout << "\t--max-ride-requests\t\t(30, step 1)" << std::endl;
+}
+
+static std::string withTrailingSlash(const std::string& folder){
+	if (folder.empty() || folder[folder.size() - 1] == '/' || folder[folder.size() - 1] == '\\'){
+		return folder;
+	}
+	return folder + '/';
+}
+
+//Reads "value", "bottom:top" or "bottom:top:step". A missing step keeps the range's current step.
+static void parseRange(const std::string& text, ParameterRange& range){
+	size_t firstColon = text.find(':');
+	range.bottom = std::stof(text.substr(0, firstColon));
+	range.top = range.bottom;
+	if (firstColon == std::string::npos){
+		return;
+	}
+	size_t secondColon = text.find(':', firstColon + 1);
+	range.top = std::stof(text.substr(firstColon + 1, secondColon - firstColon - 1));
+	if (secondColon != std::string::npos){
+		range.step = std::stof(text.substr(secondColon + 1));
+	}
+	if (range.top < range.bottom || range.step <= 0){
+		throw "Invalid parameter range!";
+	}
+}
+
+//Values are counted from the bottom of the range, so float steps do not drift past the top.
+static std::vector<float> rangeValues(const ParameterRange& range){
+	std::vector<float> values;
+	int count = (int)((range.top - range.bottom) / range.step + 0.5f) + 1;
+	for (int i = 0; i < count; i++){
+		values.push_back(range.bottom + i * range.step);
+	}
+	return values;
+}
+
+static std::string shardFileName(const std::string& testName, int shard){
+	return testName + ".shard" + std::to_string(shard) + ".txt";
+}
+
+static std::string quoteArgument(const std::string& argument){
+	return '"' + argument + '"';
+}
+
+//Runs every shard of a sweep as a copy of this program with the same options, side by side, and waits for all of them.
+static void runShardProcesses(const std::string& program, const std::vector<std::string>& arguments, int shardCount, const std::string& scenarioFile){
+	std::vector<int> exitCodes(shardCount, 0);
+	std::vector<std::thread> shards;
+	for (int shard = 0; shard < shardCount; shard++){
+		std::string command = quoteArgument(program);
+		for (const std::string& argument : arguments){
+			command += ' ' + quoteArgument(argument);
+		}
+		command += " --shard " + std::to_string(shard) + '/' + std::to_string(shardCount) + " --scenario " + quoteArgument(scenarioFile);
+#ifdef _WIN32
+		//cmd.exe strips the outer pair of quotes from a command that starts with one.
+		command = '"' + command + '"';
+#endif
+		shards.push_back(std::thread([command, shard, &exitCodes](){ exitCodes[shard] = std::system(command.c_str()); }));
+	}
+	for (std::thread& shard : shards){
+		shard.join();
+	}
+	for (int exitCode : exitCodes){
+		if (exitCode != 0){
+			throw "A shard process failed!";
+		}
+	}
+}
+
+int main(int argc, char *argv[]){
+	std::string xmlFolder = RESOURCE_FOLDER"XML/";
+	std::string testName;
+	bool ranged = false;
+	std::string resultsFolder, aggregateFolder;
+
+	unsigned timesToRun = 10;
+	unsigned fleetSize = 10;
+	unsigned requestCount = 10;
+	float maxLat = 20, maxLong = 20;
+	float sectionSize = 5;
+	int radiusSteps = 2;
+	ROUTING_METRIC routing = ROUTING_EUCLIDEAN;
+	SIMULATION_MODE simulationMode = SIMULATION_TICKS;
+	bool simulationModeSet = false;
+	DISPATCH_MODE dispatchMode = DISPATCH_GREEDY;
+	bool dispatchModeSet = false;
+	unsigned scoringThreads = 0;
+	bool scoringThreadsSet = false;
+	int processes = 0;
+	int shardIndex = 0, shardCount = 0;
+	int mergeCount = 0;
+	std::string scenarioFile, saveScenarioFile;
+	std::string exportFolder;
+	RESULTS_FORMAT resultsFormat = RESULTS_CSV;
+	bool vehicleResults = false;
+	unsigned long long seed = 0;
+	bool seedSet = false;
+	//Passed on to the shard processes, which get every option but --processes.
+	std::vector<std::string> shardArguments;
+
+	ParameterRange tripWeight = { 0.002f, 0.002f, 0.001f };
+	ParameterRange radiusMin = { 5, 5, 1 };
+	ParameterRange radiusStep = { 5, 5, 1 };
+	ParameterRange timeRadius = { 5, 5, 1 };
+	ParameterRange minimumScore = { 30, 30, 5 };
+	ParameterRange maxRideRequests = { 30, 30, 1 };
+
+	try{
+		for (int i = 1; i < argc; i++){
+			std::string option = argv[i];
+			if (option == "--help" || option == "-h"){
+				printUsage();
+				return 0;
+			}
+			if (i + 1 >= argc){
+				throw "Missing value for an option!";
+			}
+			std::string value = argv[++i];
+			if (option != "--processes"){
+				shardArguments.push_back(option);
+				shardArguments.push_back(value);
+			}
+			if (option == "--xml"){
+				xmlFolder = withTrailingSlash(value);
+				testName.clear();
+			}
+			else if (option == "--custom" || option == "--ranged"){
+				testName = value;
+				ranged = option == "--ranged";
+			}
+			else if (option == "--results"){
+				resultsFolder = withTrailingSlash(value);
+			}
+			else if (option == "--aggregate"){
+				aggregateFolder = withTrailingSlash(value);
+			}
+			else if (option == "--results-format"){
+				resultsFormat = parseResultsFormat(value);
+			}
+			else if (option == "--vehicle-results"){
+				vehicleResults = std::stoi(value) != 0;
+			}
+			else if (option == "--export"){
+				exportFolder = withTrailingSlash(value);
+			}
+			else if (option == "--times-to-run"){
+				timesToRun = std::stoi(value);
+			}
+			else if (option == "--fleet-size"){
+				fleetSize = std::stoi(value);
+			}
+			else if (option == "--request-count"){
+				requestCount = std::stoi(value);
+			}
+			else if (option == "--max-lat"){
+				maxLat = std::stof(value);
+			}
+			else if (option == "--max-long"){
+				maxLong = std::stof(value);
+			}
+			else if (option == "--section-size"){
+				sectionSize = std::stof(value);
+			}
+			else if (option == "--radius-steps"){
+				radiusSteps = std::stoi(value);
+			}
+			else if (option == "--routing"){
+				routing = parseRoutingMetric(value);
+			}
+			else if (option == "--simulation"){
+				simulationMode = parseSimulationMode(value);
+				simulationModeSet = true;
+			}
+			else if (option == "--dispatch"){
+				dispatchMode = parseDispatchMode(value);
+				dispatchModeSet = true;
+			}
+			else if (option == "--scoring-threads"){
+				scoringThreads = std::stoi(value);
+				scoringThreadsSet = true;
+			}
+			else if (option == "--processes"){
+				processes = std::stoi(value);
+			}
+			else if (option == "--shard"){
+				size_t slash = value.find('/');
+				if (slash == std::string::npos){
+					throw "Shards are given as <k>/<n>!";
+				}
+				shardIndex = std::stoi(value.substr(0, slash));
+				shardCount = std::stoi(value.substr(slash + 1));
+				if (shardCount <= 0 || shardIndex < 0 || shardIndex >= shardCount){
+					throw "Invalid shard!";
+				}
+			}
+			else if (option == "--merge"){
+				mergeCount = std::stoi(value);
+			}
+			else if (option == "--scenario"){
+				scenarioFile = value;
+			}
+			else if (option == "--save-scenario"){
+				saveScenarioFile = value;
+			}
+			else if (option == "--seed"){
+				seed = std::stoull(value);
+				seedSet = true;
+			}
+			else if (option == "--trip-weight"){
+				parseRange(value, tripWeight);
+			}
+			else if (option == "--radius-min"){
+				parseRange(value, radiusMin);
+			}
+			else if (option == "--radius-step"){
+				parseRange(value, radiusStep);
+			}
+			else if (option == "--time-radius"){
+				parseRange(value, timeRadius);
+			}
+			else if (option == "--minimum-score"){
+				parseRange(value, minimumScore);
+			}
+			else if (option == "--max-ride-requests"){
+				parseRange(value, maxRideRequests);
+			}
+			else{
+				std::cerr << "Unknown option " << option << std::endl;
+				printUsage();
+				return 1;
+			}
+		}
+
+		SimulationCore simulation;
+		//Results are written as each test finishes, so its requests and vehicles can go right away.
+		simulation.setFreeFinishedTests(true);
+		if (!resultsFolder.empty()){
+			simulation.setResultsFolder(resultsFolder);
+		}
+		simulation.setResultsFormat(resultsFormat);
+		simulation.setVehicleResults(vehicleResults);
+		if (!aggregateFolder.empty()){
+			simulation.setAggregateResultsFolder(aggregateFolder);
+		}
+
+		if ((processes > 0 || shardCount > 0 || mergeCount > 0) && !ranged){
+			throw "Only ranged sweeps can be sharded!";
+		}
+		if (!exportFolder.empty() && !testName.empty()){
+			throw "Only test files can be exported!";
+		}
+		if (mergeCount > 0){
+			std::vector<std::string> shardFiles;
+			for (int shard = 0; shard < mergeCount; shard++){
+				shardFiles.push_back(shardFileName(testName, shard));
+			}
+			simulation.setExcelFileName(testName + ".xls");
+			simulation.mergeShardFiles(shardFiles);
+			simulation.freeMemory();
+			return 0;
+		}
+		if (seedSet){
+			simulation.setRandomSeed(seed);
+		}
+		//Printed so a run drawn from a new seed can be repeated.
+		std::cout << "Random seed: " << simulation.getRandomSeed() << std::endl;
+		if (processes > 0){
+			//Every shard has to run the same scenario, so it is drawn once here and handed to them as a file.
+			if (scenarioFile.empty()){
+				scenarioFile = simulation.getAggregateResultsFolder() + testName + ".scenario";
+				simulation.initializeSimulatorWithParams(testName, timesToRun, tripWeight.bottom, radiusMin.bottom, radiusStep.bottom, radiusSteps * radiusStep.bottom + radiusMin.bottom,
+					timeRadius.bottom, minimumScore.bottom, (unsigned)maxRideRequests.bottom, fleetSize, requestCount, maxLat, maxLong, sectionSize);
+				simulation.writeScenario(testName, scenarioFile);
+				simulation.freeMemory();
+			}
+			runShardProcesses(argv[0], shardArguments, processes, scenarioFile);
+			std::vector<std::string> shardFiles;
+			for (int shard = 0; shard < processes; shard++){
+				shardFiles.push_back(shardFileName(testName, shard));
+			}
+			simulation.setExcelFileName(testName + ".xls");
+			simulation.mergeShardFiles(shardFiles);
+			simulation.freeMemory();
+			return 0;
+		}
+		simulation.setScenarioFile(scenarioFile);
+
+		if (testName.empty()){
+			simulation.loadTestFiles(xmlFolder);
+		}
+		else{
+			//Only a ranged run sweeps: a custom test takes the bottom of each range.
+			if (!ranged){
+				for (ParameterRange* range : { &tripWeight, &radiusMin, &radiusStep, &timeRadius, &minimumScore, &maxRideRequests }){
+					range->top = range->bottom;
+				}
+			}
+			int i = 1;
+			for (float weight : rangeValues(tripWeight)){
+				for (float minRadius : rangeValues(radiusMin)){
+					for (float step : rangeValues(radiusStep)){
+						for (float time : rangeValues(timeRadius)){
+							for (float score : rangeValues(minimumScore)){
+								for (float rideRequests : rangeValues(maxRideRequests)){
+									//Shards take every shardCount-th combination, so each gets a share of the cheap and the costly ones.
+									int combination = i++;
+									if (shardCount > 0 && (combination - 1) % shardCount != shardIndex){
+										continue;
+									}
+									std::string nameToUse = ranged ? testName + '_' + std::to_string(combination) : testName;
+									simulation.initializeSimulatorWithParams(nameToUse, timesToRun, weight, minRadius, step, radiusSteps * step + minRadius,
+										time, score, (unsigned)rideRequests, fleetSize, requestCount, maxLat, maxLong, sectionSize, ranged);
+									simulation.setRoutingMetric(nameToUse, routing);
+								}
+							}
+						}
+					}
+				}
+			}
+			if (ranged){
+				simulation.setExcelFileName(testName + ".xls");
+			}
+			if (shardCount > 0){
+				simulation.setShardFileName(shardFileName(testName, shardIndex));
+			}
+		}
+
+		for (const std::string& name : simulation.getTestNames()){
+			if (simulationModeSet){
+				simulation.setSimulationMode(name, simulationMode);
+			}
+			if (dispatchModeSet){
+				simulation.setDispatchMode(name, dispatchMode);
+			}
+			if (scoringThreadsSet){
+				simulation.setScoringThreads(name, scoringThreads);
+			}
+		}
+
+		if (!exportFolder.empty()){
+			for (const std::string& name : simulation.getTestNames()){
+				simulation.writeScenario(name, exportFolder + name + ".scenario");
+			}
+			simulation.freeMemory();
+			return 0;
+		}
+
+		if (!saveScenarioFile.empty() && !simulation.getTestNames().empty()){
+			simulation.writeScenario(simulation.getTestNames()[0], saveScenarioFile);
+		}
+
+		simulation.runTests();
+		simulation.freeMemory();
+	}
+	catch (const char* error){
+		std::cerr << error << std::endl;
+		return 1;
+	}
+	catch (std::exception& e){
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -1,9 +1,104 @@
 #ifndef _EVENT_HELPER_H
 #define _EVENT_HELPER_H
+#include <string>
 
 enum SIM_STATE { PARAMETER_SOURCE_CHOICE, PARAMETER_SET_VALUES, SIM_CALCULATE, SIM_VISUALIZE};
 enum BUTTON_ACTION { PARAM_MAX_LAT_DOWN, PARAM_MAX_LAT_UP, PARAM_MAX_LONG_DOWN, PARAM_MAX_LONG_UP, PARAM_TRIP_WEIGHT_UP, PARAM_TRIP_WEIGHT_DOWN,
 	PARAM_TIME_UP, PARAM_TIME_DOWN, PARAM_FLEET_SIZE_UP, PARAM_FLEET_SIZE_DOWN, PARAM_REQUEST_COUNT_UP, PARAM_REQUEST_COUNT_DOWN, PARAM_VENUE_COUNT_UP, PARAM_VENUE_COUNT_DOWN,
 	PARAMETER_SOURCE_CHOOSE_CUSTOM, PARAMTER_CHOOSE_SOURCE_FILES};
+//Scenario files store these numbers. 2 was squared Euclidean distance, which is no longer a metric.
+enum ROUTING_METRIC { ROUTING_EUCLIDEAN, ROUTING_MANHATTAN, ROUTING_GRID_GRAPH = 3 };
+enum SIMULATION_MODE { SIMULATION_TICKS, SIMULATION_EVENTS, SIMULATION_TILES };
+enum DISPATCH_MODE { DISPATCH_GREEDY, DISPATCH_BATCH, DISPATCH_PARALLEL };
+enum RESULTS_FORMAT { RESULTS_TEXT, RESULTS_CSV };
+
+//Reads the RoutingMetric parameter of a test file. Unknown names are an error, like other malformed parameters.
+inline ROUTING_METRIC parseRoutingMetric(const std::string& name){
+	if (name == "Euclidean" || name == "Pythagorean"){
+		return ROUTING_EUCLIDEAN;
+	}
+	if (name == "Manhattan"){
+		return ROUTING_MANHATTAN;
+	}
+	if (name == "GridGraph"){
+		return ROUTING_GRID_GRAPH;
+	}
+	throw "Unknown routing metric!";
+}
+
+//The name parseRoutingMetric reads back.
+inline const char* routingMetricName(ROUTING_METRIC metric){
+	switch (metric){
+	case ROUTING_MANHATTAN:
+		return "Manhattan";
+	case ROUTING_GRID_GRAPH:
+		return "GridGraph";
+	default:
+		return "Euclidean";
+	}
+}
+
+//Reads the SimulationMode parameter of a test file.
+inline SIMULATION_MODE parseSimulationMode(const std::string& name){
+	if (name == "Ticks"){
+		return SIMULATION_TICKS;
+	}
+	if (name == "Events"){
+		return SIMULATION_EVENTS;
+	}
+	if (name == "Tiles"){
+		return SIMULATION_TILES;
+	}
+	throw "Unknown simulation mode!";
+}
+
+//The name parseSimulationMode reads back.
+inline const char* simulationModeName(SIMULATION_MODE mode){
+	switch (mode){
+	case SIMULATION_EVENTS:
+		return "Events";
+	case SIMULATION_TILES:
+		return "Tiles";
+	default:
+		return "Ticks";
+	}
+}
+
+//Reads the DispatchMode parameter of a test file.
+inline DISPATCH_MODE parseDispatchMode(const std::string& name){
+	if (name == "Greedy"){
+		return DISPATCH_GREEDY;
+	}
+	if (name == "Batch"){
+		return DISPATCH_BATCH;
+	}
+	if (name == "Parallel"){
+		return DISPATCH_PARALLEL;
+	}
+	throw "Unknown dispatch mode!";
+}
+
+//The name parseDispatchMode reads back.
+inline const char* dispatchModeName(DISPATCH_MODE mode){
+	switch (mode){
+	case DISPATCH_BATCH:
+		return "Batch";
+	case DISPATCH_PARALLEL:
+		return "Parallel";
+	default:
+		return "Greedy";
+	}
+}
+
+//Reads the --results-format option of the batch runner.
+inline RESULTS_FORMAT parseResultsFormat(const std::string& name){
+	if (name == "Text"){
+		return RESULTS_TEXT;
+	}
+	if (name == "Csv"){
+		return RESULTS_CSV;
+	}
+	throw "Unknown results format!";
+}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "ScoringKernel.h"
+#include <vector>
+#include <random>
+#include <iostream>
+#include <cstdlib>
+#include <stdint.h>
+
+//Checks the vector paths of the scoring kernel against its scalar path: every candidate of a random batch must get the
+//same distances, feasibility and score as when it is scored alone, in a batch too small for a vector. Batches hold 0 to
+//45 candidates, mostly not a multiple of the vector width, so the scalar tail after the vectors runs too. Run by
+//"make check".
+
+#if defined(__AVX__)
+static const char* VECTOR_PATH = "AVX";
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+static const char* VECTOR_PATH = "SSE2";
+#else
+static const char* VECTOR_PATH = "none";
+#endif
+
+//What the batch holds before scoring: the candidate's request, and the requests at its destination.
+static void copyCandidate(const CandidateBatch& from, size_t i, CandidateBatch& to){
+	to.pickupLatitude.push_back(from.pickupLatitude[i]);
+	to.pickupLongitude.push_back(from.pickupLongitude[i]);
+	to.destinationLatitude.push_back(from.destinationLatitude[i]);
+	to.destinationLongitude.push_back(from.destinationLongitude[i]);
+	to.cachedRideDistance.push_back(from.cachedRideDistance[i]);
+	to.requestTime.push_back(from.requestTime[i]);
+	to.requestsAtDestination.push_back(from.requestsAtDestination[i]);
+}
+
+//Equal, or both not a number: a candidate at the vehicle whose ride goes nowhere scores 0 / 0 on either path.
+static bool same(float a, float b){
+	return a == b || (a != a && b != b);
+}
+
+template<class Routing>
+static void scoreBatch(CandidateBatch& batch, float vehicleLatitude, float vehicleLongitude, int timeToUse, int timeRadius, float weightOfDistanceOfRide, int maxRideRequests){
+	computeCandidateDistances<Routing>(batch, vehicleLatitude, vehicleLongitude);
+	markFeasibleCandidates(batch, timeToUse, timeRadius);
+	scoreCandidates(batch, weightOfDistanceOfRide, maxRideRequests);
+}
+
+int main(int argc, char** argv){
+	const int batchCount = argc > 1 ? std::atoi(argv[1]) : 20000;
+	const uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+	//Ceilings of 3 or less shrink the destination penalty per request; above 3 its step is 0.
+	const int maxRideRequests[] = { 0, 1, 2, 3, 4, 7, 30 };
+	std::mt19937_64 random(seed);
+	std::uniform_int_distribution<int> size(0, 45), coordinate(0, 30), time(0, 100), offset(-5, 50), radius(0, 40), requests(0, 40), coin(0, 3), ceilingChoice(0, 6);
+	std::uniform_real_distribution<float> fraction(0, 1), weight(0.001f, 0.01f);
+	CandidateBatch batch, single;
+	int failures = 0;
+	size_t candidateCount = 0, infeasibleCount = 0;
+	for (int batchNumber = 0; batchNumber < batchCount; batchNumber++){
+		bool manhattan = coin(random) < 2;
+		//Vehicles stand on whole coordinates. Moving a quarter of them off makes pickup distances that round up.
+		bool fractional = coin(random) == 0;
+		float vehicleLatitude = coordinate(random) + (fractional ? fraction(random) : 0);
+		float vehicleLongitude = coordinate(random) + (fractional ? fraction(random) : 0);
+		int timeToUse = time(random);
+		int timeRadius = radius(random);
+		float weightOfDistanceOfRide = weight(random);
+		int ceiling = maxRideRequests[ceilingChoice(random)];
+
+		batch.clear();
+		int count = size(random);
+		for (int i = 0; i < count; i++){
+			batch.pickupLatitude.push_back((float)coordinate(random));
+			batch.pickupLongitude.push_back((float)coordinate(random));
+			batch.destinationLatitude.push_back((float)coordinate(random));
+			batch.destinationLongitude.push_back((float)coordinate(random));
+			batch.cachedRideDistance.push_back(coin(random) == 0 ? (float)coordinate(random) : -1);
+			//From a few ticks in the past to well past the window, so some candidates cannot be reached in time.
+			batch.requestTime.push_back((float)(timeToUse + offset(random)));
+			batch.requestsAtDestination.push_back((float)requests(random));
+		}
+		if (manhattan){
+			scoreBatch<ManhattanRouting>(batch, vehicleLatitude, vehicleLongitude, timeToUse, timeRadius, weightOfDistanceOfRide, ceiling);
+		}
+		else{
+			scoreBatch<EuclideanRouting>(batch, vehicleLatitude, vehicleLongitude, timeToUse, timeRadius, weightOfDistanceOfRide, ceiling);
+		}
+
+		for (size_t i = 0; i < batch.size(); i++){
+			single.clear();
+			copyCandidate(batch, i, single);
+			if (manhattan){
+				scoreBatch<ManhattanRouting>(single, vehicleLatitude, vehicleLongitude, timeToUse, timeRadius, weightOfDistanceOfRide, ceiling);
+			}
+			else{
+				scoreBatch<EuclideanRouting>(single, vehicleLatitude, vehicleLongitude, timeToUse, timeRadius, weightOfDistanceOfRide, ceiling);
+			}
+			candidateCount++;
+			if (!single.feasible[0]){
+				infeasibleCount++;
+			}
+			if (!same(batch.pickupDistance[i], single.pickupDistance[0]) || !same(batch.rideDistance[i], single.rideDistance[0]) ||
+				batch.feasible[i] != single.feasible[0] || !same(batch.score[i], single.score[0])){
+				failures++;
+				std::cout << "Batch " << batchNumber << ", candidate " << i << " of " << batch.size() << (manhattan ? ", Manhattan" : ", Euclidean") << ", ceiling " << ceiling
+					<< ": pickup " << batch.pickupDistance[i] << " / " << single.pickupDistance[0] << ", ride " << batch.rideDistance[i] << " / " << single.rideDistance[0]
+					<< ", feasible " << batch.feasible[i] << " / " << single.feasible[0] << ", score " << batch.score[i] << " / " << single.score[0] << std::endl;
+			}
+		}
+	}
+	std::cout << candidateCount - failures << " of " << candidateCount << " candidates (" << infeasibleCount << " infeasible) in " << batchCount
+		<< " batches scored alike by the " << VECTOR_PATH << " and scalar paths." << std::endl;
+	return failures == 0 ? 0 : 1;
+}
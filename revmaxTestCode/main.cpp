@@ -4,7 +4,7 @@
 #endif
 #include "Vehicle.h"
 #include "RequestManager.h"
-#include "RideRequest.h"
+#include "RideRequestStore.h"
 #include "mathHelper.h"
 #include "Simulator.h"
 #include "ShaderProgram.h"
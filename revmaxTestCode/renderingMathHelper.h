@@ -4,11 +4,6 @@
 #include <unordered_map>
 #include <SDL_image.h>
 
-inline float motion(float pos1, float pos2, float time1, float time2){
-	float diff = pos2 - pos1;
-	return (float)(pos1 + (diff * pow((time1 / time2), 5)));
-}
-
 inline GLuint loadTexture(const char* imagePath){
 	static std::unordered_map<std::string, GLuint> loadedTextures;
 	if (loadedTextures.find(imagePath) == loadedTextures.end()){